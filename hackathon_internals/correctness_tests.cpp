@@ -3,8 +3,10 @@
 #include <cstring>
 #include <random>
 #include <vector>
+#include <algorithm>
 #include <stdlib.h>
 #include <iostream>
+#include <omp.h>
 #include "tests.hpp"
 
 const TestCaseBits testcases_bits[NUM_OF_TESTCASES_BITS] = {
@@ -102,6 +104,51 @@ TestCaseAES testcases_aes[NUM_OF_TESTCASES_AES] = {
     .tag = {0xD8, 0x34, 0x7D, 0xEB, 0x0E, 0x6D, 0x2C, 0xB9, 0x87, 0x13, 0xE2, 0x5E, 0x7B, 0x52, 0x16, 0xC5}},
 };
 
+TestCaseAESAAD testcases_aes_aad[NUM_OF_TESTCASES_AES_AAD] = {
+    {.n = 60,
+    .key = {0xFE, 0xFF, 0xE9, 0x92, 0x86, 0x65, 0x73, 0x1C, 0x6D, 0x6A, 0x8F, 0x94, 0x67, 0x30, 0x83, 0x08, 0xFE, 0xFF, 0xE9, 0x92, 0x86, 0x65, 0x73, 0x1C, 0x6D, 0x6A, 0x8F, 0x94, 0x67, 0x30, 0x83, 0x08},
+    .iv = {0xCA, 0xFE, 0xBA, 0xBE, 0xFA, 0xCE, 0xDB, 0xAD, 0xDE, 0xCA, 0xF8, 0x88},
+    .aad = {0xFE, 0xED, 0xFA, 0xCE, 0xDE, 0xAD, 0xBE, 0xEF, 0xFE, 0xED, 0xFA, 0xCE, 0xDE, 0xAD, 0xBE, 0xEF, 0xAB, 0xAD, 0xDA, 0xD2},
+    .plaintext = {0xD9, 0x31, 0x32, 0x25, 0xF8, 0x84, 0x06, 0xE5, 0xA5, 0x59, 0x09, 0xC5, 0xAF, 0xF5, 0x26, 0x9A, 0x86, 0xA7, 0xA9, 0x53, 0x15, 0x34, 0xF7, 0xDA, 0x2E, 0x4C, 0x30, 0x3D, 0x8A, 0x31, 0x8A, 0x72, 0x1C, 0x3C, 0x0C, 0x95, 0x95, 0x68, 0x09, 0x53, 0x2F, 0xCF, 0x0E, 0x24, 0x49, 0xA6, 0xB5, 0x25, 0xB1, 0x6A, 0xED, 0xF5, 0xAA, 0x0D, 0xE6, 0x57, 0xBA, 0x63, 0x7B, 0x39},
+    .ciphertext = {0x52, 0x2D, 0xC1, 0xF0, 0x99, 0x56, 0x7D, 0x07, 0xF4, 0x7F, 0x37, 0xA3, 0x2A, 0x84, 0x42, 0x7D, 0x64, 0x3A, 0x8C, 0xDC, 0xBF, 0xE5, 0xC0, 0xC9, 0x75, 0x98, 0xA2, 0xBD, 0x25, 0x55, 0xD1, 0xAA, 0x8C, 0xB0, 0x8E, 0x48, 0x59, 0x0D, 0xBB, 0x3D, 0xA7, 0xB0, 0x8B, 0x10, 0x56, 0x82, 0x88, 0x38, 0xC5, 0xF6, 0x1E, 0x63, 0x93, 0xBA, 0x7A, 0x0A, 0xBC, 0xC9, 0xF6, 0x62},
+    .tag = {0x76, 0xFC, 0x6E, 0xCE, 0x0F, 0x4E, 0x17, 0x68, 0xCD, 0xDF, 0x88, 0x53, 0xBB, 0x2D, 0x55, 0x1B}},
+
+    {.n = 0,
+    .key = {0xBF, 0x49, 0xF1, 0x0F, 0x40, 0xCD, 0xE7, 0x3E, 0x20, 0xAE, 0xDD, 0x82, 0xC2, 0x71, 0x48, 0x3E, 0x9D, 0xC9, 0x7C, 0x00, 0x8A, 0x9A, 0xD0, 0x0B, 0x5E, 0x56, 0x8A, 0x2D, 0xC8, 0xEA, 0xC3, 0x0B},
+    .iv = {0x13, 0x89, 0x47, 0xDF, 0xD7, 0xE6, 0x4E, 0x1B, 0xD4, 0x4A, 0x46, 0x1A},
+    .aad = {0x2F, 0x83, 0xED, 0x07, 0x7E, 0xF6, 0x64, 0x87, 0x8C, 0x89, 0xFD, 0xBA, 0xAA, 0x88, 0x27, 0xBC, 0x36, 0x6C, 0x50, 0x77},
+    .plaintext = {},
+    .ciphertext = {},
+    .tag = {0x5D, 0x3B, 0x32, 0x32, 0x75, 0x30, 0xF9, 0x4C, 0x14, 0xC6, 0x21, 0xB6, 0xEF, 0x7F, 0xDF, 0x60}},
+
+    {.n = 51,
+    .key = {0x81, 0x28, 0x15, 0x7C, 0x8A, 0x18, 0x03, 0xF8, 0xDC, 0x71, 0xA6, 0x41, 0x97, 0x7E, 0x43, 0xA9, 0x64, 0x4D, 0x71, 0x4E, 0x7D, 0xC6, 0x0C, 0x3E, 0xAF, 0xE0, 0x43, 0x52, 0x4C, 0xB5, 0x7F, 0x79},
+    .iv = {0xB2, 0xA8, 0xF9, 0x8A, 0x15, 0xDC, 0x2F, 0xCE, 0xAE, 0x04, 0x98, 0xE8},
+    .aad = {0x3A, 0x58, 0xC6, 0x1D, 0x9F, 0xC4, 0xD1, 0xE4, 0xEA, 0x48, 0xAF, 0xD1, 0xFC, 0xD6, 0x19, 0xAB, 0x08, 0x34, 0x34, 0x59, 0xD5, 0x15, 0xED, 0xA6, 0xC0, 0x60, 0x77, 0x97, 0x22, 0xEF, 0xAA, 0x52, 0xE5, 0xE4, 0x89, 0x43, 0x32},
+    .plaintext = {0x82, 0xED, 0x87, 0x1F, 0xD1, 0xA0, 0xE3, 0xF7, 0x5C, 0x74, 0x10, 0x4B, 0x88, 0x1C, 0x77, 0xB1, 0x4B, 0xC1, 0xB4, 0x2D, 0xF7, 0x1D, 0xFC, 0x84, 0x97, 0x79, 0x15, 0x46, 0x97, 0xCD, 0xB4, 0x0F, 0x4E, 0xFC, 0x4B, 0x8F, 0x80, 0x4D, 0x42, 0x52, 0x98, 0x32, 0xC3, 0x93, 0xE7, 0x7E, 0x0C, 0xE2, 0xD3, 0xB4, 0x5F},
+    .ciphertext = {0xFE, 0x16, 0xDB, 0x0C, 0xBB, 0x0B, 0x33, 0x19, 0x60, 0xEF, 0x6D, 0x13, 0xE8, 0x5A, 0x12, 0xE1, 0x19, 0x60, 0x9A, 0xBF, 0x20, 0xCC, 0x97, 0xDE, 0x62, 0xFB, 0x5E, 0x98, 0x22, 0xFC, 0xAF, 0x62, 0x05, 0x85, 0x4B, 0x9C, 0xF9, 0x48, 0x44, 0xF8, 0x57, 0x38, 0xA0, 0x73, 0x08, 0x67, 0xC2, 0xED, 0x75, 0x02, 0x6C},
+    .tag = {0x74, 0x6C, 0x6C, 0xFC, 0x7B, 0x13, 0xD7, 0x6A, 0xDE, 0xF1, 0xA6, 0x82, 0xC7, 0x4C, 0xD6, 0xBE}},
+};
+
+// RFC 8439: пример AEAD из раздела 2.8.2 и вектор расшифрования из A.5
+TestCaseAESAAD testcases_chacha[NUM_OF_TESTCASES_CHACHA] = {
+    {.n = 114,
+    .key = {0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F, 0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D, 0x9E, 0x9F},
+    .iv = {0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47},
+    .aad = {0x50, 0x51, 0x52, 0x53, 0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7},
+    .plaintext = {0x4C, 0x61, 0x64, 0x69, 0x65, 0x73, 0x20, 0x61, 0x6E, 0x64, 0x20, 0x47, 0x65, 0x6E, 0x74, 0x6C, 0x65, 0x6D, 0x65, 0x6E, 0x20, 0x6F, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x63, 0x6C, 0x61, 0x73, 0x73, 0x20, 0x6F, 0x66, 0x20, 0x27, 0x39, 0x39, 0x3A, 0x20, 0x49, 0x66, 0x20, 0x49, 0x20, 0x63, 0x6F, 0x75, 0x6C, 0x64, 0x20, 0x6F, 0x66, 0x66, 0x65, 0x72, 0x20, 0x79, 0x6F, 0x75, 0x20, 0x6F, 0x6E, 0x6C, 0x79, 0x20, 0x6F, 0x6E, 0x65, 0x20, 0x74, 0x69, 0x70, 0x20, 0x66, 0x6F, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x66, 0x75, 0x74, 0x75, 0x72, 0x65, 0x2C, 0x20, 0x73, 0x75, 0x6E, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6E, 0x20, 0x77, 0x6F, 0x75, 0x6C, 0x64, 0x20, 0x62, 0x65, 0x20, 0x69, 0x74, 0x2E},
+    .ciphertext = {0xD3, 0x1A, 0x8D, 0x34, 0x64, 0x8E, 0x60, 0xDB, 0x7B, 0x86, 0xAF, 0xBC, 0x53, 0xEF, 0x7E, 0xC2, 0xA4, 0xAD, 0xED, 0x51, 0x29, 0x6E, 0x08, 0xFE, 0xA9, 0xE2, 0xB5, 0xA7, 0x36, 0xEE, 0x62, 0xD6, 0x3D, 0xBE, 0xA4, 0x5E, 0x8C, 0xA9, 0x67, 0x12, 0x82, 0xFA, 0xFB, 0x69, 0xDA, 0x92, 0x72, 0x8B, 0x1A, 0x71, 0xDE, 0x0A, 0x9E, 0x06, 0x0B, 0x29, 0x05, 0xD6, 0xA5, 0xB6, 0x7E, 0xCD, 0x3B, 0x36, 0x92, 0xDD, 0xBD, 0x7F, 0x2D, 0x77, 0x8B, 0x8C, 0x98, 0x03, 0xAE, 0xE3, 0x28, 0x09, 0x1B, 0x58, 0xFA, 0xB3, 0x24, 0xE4, 0xFA, 0xD6, 0x75, 0x94, 0x55, 0x85, 0x80, 0x8B, 0x48, 0x31, 0xD7, 0xBC, 0x3F, 0xF4, 0xDE, 0xF0, 0x8E, 0x4B, 0x7A, 0x9D, 0xE5, 0x76, 0xD2, 0x65, 0x86, 0xCE, 0xC6, 0x4B, 0x61, 0x16},
+    .tag = {0x1A, 0xE1, 0x0B, 0x59, 0x4F, 0x09, 0xE2, 0x6A, 0x7E, 0x90, 0x2E, 0xCB, 0xD0, 0x60, 0x06, 0x91}},
+
+    {.n = 265,
+    .key = {0x1C, 0x92, 0x40, 0xA5, 0xEB, 0x55, 0xD3, 0x8A, 0xF3, 0x33, 0x88, 0x86, 0x04, 0xF6, 0xB5, 0xF0, 0x47, 0x39, 0x17, 0xC1, 0x40, 0x2B, 0x80, 0x09, 0x9D, 0xCA, 0x5C, 0xBC, 0x20, 0x70, 0x75, 0xC0},
+    .iv = {0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08},
+    .aad = {0xF3, 0x33, 0x88, 0x86, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4E, 0x91},
+    .plaintext = {0x49, 0x6E, 0x74, 0x65, 0x72, 0x6E, 0x65, 0x74, 0x2D, 0x44, 0x72, 0x61, 0x66, 0x74, 0x73, 0x20, 0x61, 0x72, 0x65, 0x20, 0x64, 0x72, 0x61, 0x66, 0x74, 0x20, 0x64, 0x6F, 0x63, 0x75, 0x6D, 0x65, 0x6E, 0x74, 0x73, 0x20, 0x76, 0x61, 0x6C, 0x69, 0x64, 0x20, 0x66, 0x6F, 0x72, 0x20, 0x61, 0x20, 0x6D, 0x61, 0x78, 0x69, 0x6D, 0x75, 0x6D, 0x20, 0x6F, 0x66, 0x20, 0x73, 0x69, 0x78, 0x20, 0x6D, 0x6F, 0x6E, 0x74, 0x68, 0x73, 0x20, 0x61, 0x6E, 0x64, 0x20, 0x6D, 0x61, 0x79, 0x20, 0x62, 0x65, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x64, 0x2C, 0x20, 0x72, 0x65, 0x70, 0x6C, 0x61, 0x63, 0x65, 0x64, 0x2C, 0x20, 0x6F, 0x72, 0x20, 0x6F, 0x62, 0x73, 0x6F, 0x6C, 0x65, 0x74, 0x65, 0x64, 0x20, 0x62, 0x79, 0x20, 0x6F, 0x74, 0x68, 0x65, 0x72, 0x20, 0x64, 0x6F, 0x63, 0x75, 0x6D, 0x65, 0x6E, 0x74, 0x73, 0x20, 0x61, 0x74, 0x20, 0x61, 0x6E, 0x79, 0x20, 0x74, 0x69, 0x6D, 0x65, 0x2E, 0x20, 0x49, 0x74, 0x20, 0x69, 0x73, 0x20, 0x69, 0x6E, 0x61, 0x70, 0x70, 0x72, 0x6F, 0x70, 0x72, 0x69, 0x61, 0x74, 0x65, 0x20, 0x74, 0x6F, 0x20, 0x75, 0x73, 0x65, 0x20, 0x49, 0x6E, 0x74, 0x65, 0x72, 0x6E, 0x65, 0x74, 0x2D, 0x44, 0x72, 0x61, 0x66, 0x74, 0x73, 0x20, 0x61, 0x73, 0x20, 0x72, 0x65, 0x66, 0x65, 0x72, 0x65, 0x6E, 0x63, 0x65, 0x20, 0x6D, 0x61, 0x74, 0x65, 0x72, 0x69, 0x61, 0x6C, 0x20, 0x6F, 0x72, 0x20, 0x74, 0x6F, 0x20, 0x63, 0x69, 0x74, 0x65, 0x20, 0x74, 0x68, 0x65, 0x6D, 0x20, 0x6F, 0x74, 0x68, 0x65, 0x72, 0x20, 0x74, 0x68, 0x61, 0x6E, 0x20, 0x61, 0x73, 0x20, 0x2F, 0xE2, 0x80, 0x9C, 0x77, 0x6F, 0x72, 0x6B, 0x20, 0x69, 0x6E, 0x20, 0x70, 0x72, 0x6F, 0x67, 0x72, 0x65, 0x73, 0x73, 0x2E, 0x2F, 0xE2, 0x80, 0x9D},
+    .ciphertext = {0x64, 0xA0, 0x86, 0x15, 0x75, 0x86, 0x1A, 0xF4, 0x60, 0xF0, 0x62, 0xC7, 0x9B, 0xE6, 0x43, 0xBD, 0x5E, 0x80, 0x5C, 0xFD, 0x34, 0x5C, 0xF3, 0x89, 0xF1, 0x08, 0x67, 0x0A, 0xC7, 0x6C, 0x8C, 0xB2, 0x4C, 0x6C, 0xFC, 0x18, 0x75, 0x5D, 0x43, 0xEE, 0xA0, 0x9E, 0xE9, 0x4E, 0x38, 0x2D, 0x26, 0xB0, 0xBD, 0xB7, 0xB7, 0x3C, 0x32, 0x1B, 0x01, 0x00, 0xD4, 0xF0, 0x3B, 0x7F, 0x35, 0x58, 0x94, 0xCF, 0x33, 0x2F, 0x83, 0x0E, 0x71, 0x0B, 0x97, 0xCE, 0x98, 0xC8, 0xA8, 0x4A, 0xBD, 0x0B, 0x94, 0x81, 0x14, 0xAD, 0x17, 0x6E, 0x00, 0x8D, 0x33, 0xBD, 0x60, 0xF9, 0x82, 0xB1, 0xFF, 0x37, 0xC8, 0x55, 0x97, 0x97, 0xA0, 0x6E, 0xF4, 0xF0, 0xEF, 0x61, 0xC1, 0x86, 0x32, 0x4E, 0x2B, 0x35, 0x06, 0x38, 0x36, 0x06, 0x90, 0x7B, 0x6A, 0x7C, 0x02, 0xB0, 0xF9, 0xF6, 0x15, 0x7B, 0x53, 0xC8, 0x67, 0xE4, 0xB9, 0x16, 0x6C, 0x76, 0x7B, 0x80, 0x4D, 0x46, 0xA5, 0x9B, 0x52, 0x16, 0xCD, 0xE7, 0xA4, 0xE9, 0x90, 0x40, 0xC5, 0xA4, 0x04, 0x33, 0x22, 0x5E, 0xE2, 0x82, 0xA1, 0xB0, 0xA0, 0x6C, 0x52, 0x3E, 0xAF, 0x45, 0x34, 0xD7, 0xF8, 0x3F, 0xA1, 0x15, 0x5B, 0x00, 0x47, 0x71, 0x8C, 0xBC, 0x54, 0x6A, 0x0D, 0x07, 0x2B, 0x04, 0xB3, 0x56, 0x4E, 0xEA, 0x1B, 0x42, 0x22, 0x73, 0xF5, 0x48, 0x27, 0x1A, 0x0B, 0xB2, 0x31, 0x60, 0x53, 0xFA, 0x76, 0x99, 0x19, 0x55, 0xEB, 0xD6, 0x31, 0x59, 0x43, 0x4E, 0xCE, 0xBB, 0x4E, 0x46, 0x6D, 0xAE, 0x5A, 0x10, 0x73, 0xA6, 0x72, 0x76, 0x27, 0x09, 0x7A, 0x10, 0x49, 0xE6, 0x17, 0xD9, 0x1D, 0x36, 0x10, 0x94, 0xFA, 0x68, 0xF0, 0xFF, 0x77, 0x98, 0x71, 0x30, 0x30, 0x5B, 0xEA, 0xBA, 0x2E, 0xDA, 0x04, 0xDF, 0x99, 0x7B, 0x71, 0x4D, 0x6C, 0x6F, 0x2C, 0x29, 0xA6, 0xAD, 0x5C, 0xB4, 0x02, 0x2B, 0x02, 0x70, 0x9B},
+    .tag = {0xEE, 0xAD, 0x9D, 0x67, 0x89, 0x0C, 0xBB, 0x22, 0x39, 0x23, 0x36, 0xFE, 0xA1, 0x85, 0x1F, 0x38}}
+};
+
 TestCaseCRC32 testcases_crc32[NUM_OF_TESTCASES_CRC32] = {
     {
         .input = "Hello, World!",
@@ -145,6 +192,43 @@ TestCaseCRC32 testcases_crc32[NUM_OF_TESTCASES_CRC32] = {
     },
 };
 
+// RFC 3720, приложение B.4, и контрольное значение "123456789"
+TestCaseCRC32 testcases_crc32c[NUM_OF_TESTCASES_CRC32C] = {
+    {
+        .input = std::string(32, '\x00'),
+        .result = 0x8A9136AA,
+    },
+    {
+        .input = std::string(32, '\xFF'),
+        .result = 0x62A8AB43,
+    },
+    {
+        .input = std::string("\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E\x0F"
+                             "\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1A\x1B\x1C\x1D\x1E\x1F", 32),
+        .result = 0x46DD794E,
+    },
+    {
+        .input = std::string("\x1F\x1E\x1D\x1C\x1B\x1A\x19\x18\x17\x16\x15\x14\x13\x12\x11\x10"
+                             "\x0F\x0E\x0D\x0C\x0B\x0A\x09\x08\x07\x06\x05\x04\x03\x02\x01\x00", 32),
+        .result = 0x113FDB5C,
+    },
+    {
+        // iSCSI Read (10) Command PDU
+        .input = std::string("\x01\xC0\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+                             "\x14\x00\x00\x00\x00\x00\x04\x00\x00\x00\x00\x14\x00\x00\x00\x18"
+                             "\x28\x00\x00\x00\x00\x00\x00\x00\x02\x00\x00\x00\x00\x00\x00\x00", 48),
+        .result = 0xD9963A56,
+    },
+    {
+        .input = "123456789",
+        .result = 0xE3069283,
+    },
+    {
+        .input = "",
+        .result = 0x00000000,
+    },
+};
+
 SampleMoments get_sample_moments(uint32_t n, float *result) {
     SampleMoments sample;
     sample.m1 = 0.0f;
@@ -463,38 +547,1499 @@ bool test_aes256_gcm() {
     return true;
 }
 
-bool test_crc32() {
-    printf("Running CRC32 tests...\n");
+bool test_aes256_gcm_context() {
+    printf("Running AES-256-GCM key context tests...\n");
+    
+    for (size_t i = 0; i < NUM_OF_TESTCASES_AES; ++i) {
+        printf("  Test %zu: data size = %zu bytes\n", i + 1, testcases_aes[i].n);
+        
+        Aes256GcmContext ctx;
+        Status status = aes256_gcm_init(&ctx, testcases_aes[i].key.data());
+        if (status != STATUS_OK) {
+            printf("    ERROR: aes256_gcm_init function returned status %d\n", status);
+            return false;
+        }
+        
+        // Один контекст используется для нескольких сообщений подряд
+        for (int pass = 0; pass < 2; ++pass) {
+            std::vector<uint8_t> answer(testcases_aes[i].n);
+            uint8_t tag[16];
+            
+            status = aes256_gcm_encrypt(&ctx, testcases_aes[i].plaintext.data(), answer.data(),
+                                        testcases_aes[i].iv.data(), testcases_aes[i].n, tag);
+            if (status != STATUS_OK) {
+                printf("    ERROR: aes256_gcm_encrypt function returned status %d\n", status);
+                return false;
+            }
+            
+            if (memcmp(answer.data(), testcases_aes[i].ciphertext.data(), testcases_aes[i].n) != 0) {
+                printf("    ERROR: Ciphertext mismatch on pass %d\n", pass + 1);
+                return false;
+            }
+            
+            if (memcmp(tag, testcases_aes[i].tag.data(), 16) != 0) {
+                printf("    ERROR: Tag mismatch on pass %d\n", pass + 1);
+                return false;
+            }
+        }
+        
+        printf("    OK\n");
+    }
+    
+    printf("test_aes256_gcm_context: OK\n");
+    return true;
+}
+
+// Прогоняет все векторы AES-256-GCM на реализациях, выбранных в данный момент
+static bool check_aes_vectors() {
+    for (size_t i = 0; i < NUM_OF_TESTCASES_AES; ++i) {
+        std::vector<uint8_t> answer(testcases_aes[i].n);
+        uint8_t tag[16];
+        
+        Aes256GcmContext ctx;
+        Status status = aes256_gcm_init(&ctx, testcases_aes[i].key.data());
+        if (status == STATUS_OK) {
+            status = aes256_gcm_encrypt(&ctx, testcases_aes[i].plaintext.data(), answer.data(),
+                                        testcases_aes[i].iv.data(), testcases_aes[i].n, tag);
+        }
+        if (status != STATUS_OK) {
+            printf("    ERROR: test %zu returned status %d\n", i + 1, status);
+            return false;
+        }
+        
+        if (memcmp(answer.data(), testcases_aes[i].ciphertext.data(), testcases_aes[i].n) != 0 ||
+            memcmp(tag, testcases_aes[i].tag.data(), 16) != 0) {
+            printf("    ERROR: test %zu ciphertext or tag mismatch\n", i + 1);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool test_aes256_gcm_backends() {
+    printf("Running AES-256-GCM backend tests...\n");
+    
+    const AesBackend aes_backends[] = {AES_BACKEND_BYTEWISE, AES_BACKEND_TTABLE, AES_BACKEND_BITSLICED, AES_BACKEND_AESNI,
+                                       AES_BACKEND_VAES};
+    const char* aes_names[] = {"bytewise", "ttable", "bitsliced", "aesni", "vaes"};
+    const GhashBackend ghash_backends[] = {GHASH_BACKEND_BITWISE, GHASH_BACKEND_SHOUP4, GHASH_BACKEND_SHOUP8, GHASH_BACKEND_CLMUL,
+                                           GHASH_BACKEND_VPCLMUL};
+    const char* ghash_names[] = {"bitwise", "shoup4", "shoup8", "clmul", "vpclmul"};
+    bool ok = true;
+    
+    for (size_t a = 0; a < sizeof(aes_backends) / sizeof(aes_backends[0]) && ok; ++a) {
+        if (aes256_set_backend(aes_backends[a]) != STATUS_OK) {
+            printf("  AES %s: not supported on this CPU, skipped\n", aes_names[a]);
+            continue;
+        }
+        
+        for (size_t g = 0; g < sizeof(ghash_backends) / sizeof(ghash_backends[0]) && ok; ++g) {
+            if (aes256_gcm_set_ghash_backend(ghash_backends[g]) != STATUS_OK) {
+                printf("  AES %s, GHASH %s: not supported on this CPU, skipped\n", aes_names[a], ghash_names[g]);
+                continue;
+            }
+            
+            printf("  AES %s, GHASH %s\n", aes_names[a], ghash_names[g]);
+            ok = check_aes_vectors();
+            if (ok) {
+                printf("    OK\n");
+            }
+        }
+    }
+    
+    aes256_set_backend(AES_BACKEND_AUTO);
+    aes256_gcm_set_ghash_backend(GHASH_BACKEND_AUTO);
+    
+    if (!ok) {
+        return false;
+    }
+    
+    printf("test_aes256_gcm_backends: OK\n");
+    return true;
+}
+
+// Шифрует сообщение потоком, разрезая его на куски длины chunk
+static Status stream_encrypt(const Aes256GcmContext* ctx, const uint8_t* iv, const uint8_t* plaintext,
+                             uint8_t* ciphertext, size_t n, size_t chunk, uint8_t* tag) {
+    Aes256GcmStream stream;
+    Status status = aes256_gcm_stream_init(&stream, ctx, iv);
+    for (size_t pos = 0; pos < n && status == STATUS_OK; pos += chunk) {
+        size_t len = (pos + chunk <= n) ? chunk : n - pos;
+        status = aes256_gcm_stream_update(&stream, plaintext + pos, ciphertext + pos, len);
+    }
+    if (status == STATUS_OK) {
+        status = aes256_gcm_stream_final(&stream, tag);
+    }
+    return status;
+}
+
+bool test_aes256_gcm_stream() {
+    printf("Running AES-256-GCM streaming tests...\n");
+    
+    const size_t chunks[] = {1, 5, 16, 17, 1000};
+    
+    for (size_t i = 0; i < NUM_OF_TESTCASES_AES; ++i) {
+        printf("  Test %zu: data size = %zu bytes\n", i + 1, testcases_aes[i].n);
+        
+        Aes256GcmContext ctx;
+        aes256_gcm_init(&ctx, testcases_aes[i].key.data());
+        
+        for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); ++c) {
+            std::vector<uint8_t> answer(testcases_aes[i].n);
+            uint8_t tag[16];
+            
+            Status status = stream_encrypt(&ctx, testcases_aes[i].iv.data(), testcases_aes[i].plaintext.data(),
+                                           answer.data(), testcases_aes[i].n, chunks[c], tag);
+            if (status != STATUS_OK) {
+                printf("    ERROR: streaming with %zu-byte updates returned status %d\n", chunks[c], status);
+                return false;
+            }
+            
+            if (memcmp(answer.data(), testcases_aes[i].ciphertext.data(), testcases_aes[i].n) != 0 ||
+                memcmp(tag, testcases_aes[i].tag.data(), 16) != 0) {
+                printf("    ERROR: ciphertext or tag mismatch with %zu-byte updates\n", chunks[c]);
+                return false;
+            }
+        }
+        
+        printf("    OK\n");
+    }
+    
+    // Большое сообщение: куски разной длины против однократного шифрования
+    const size_t n = 300007;
+    std::vector<uint8_t> plaintext(n), expected(n), answer(n);
+    std::mt19937 gen(42);
+    for (size_t j = 0; j < n; j++) {
+        plaintext[j] = (uint8_t)gen();
+    }
+    
+    Aes256GcmContext ctx;
+    aes256_gcm_init(&ctx, testcases_aes[0].key.data());
+    const uint8_t* iv = testcases_aes[0].iv.data();
+    
+    uint8_t expected_tag[16], tag[16];
+    aes256_gcm_encrypt(&ctx, plaintext.data(), expected.data(), iv, n, expected_tag);
+    
+    printf("  Test %d: data size = %zu bytes, random update sizes\n", NUM_OF_TESTCASES_AES + 1, n);
+    Aes256GcmStream stream;
+    aes256_gcm_stream_init(&stream, &ctx, iv);
+    for (size_t pos = 0; pos < n;) {
+        size_t len = gen() % 70000;
+        if (len > n - pos) {
+            len = n - pos;
+        }
+        aes256_gcm_stream_update(&stream, plaintext.data() + pos, answer.data() + pos, len);
+        pos += len;
+    }
+    aes256_gcm_stream_final(&stream, tag);
+    
+    if (answer != expected || memcmp(tag, expected_tag, 16) != 0) {
+        printf("    ERROR: ciphertext or tag differs from aes256_gcm_encrypt\n");
+        return false;
+    }
+    printf("    OK\n");
+    
+    // Завершённый поток отвергает любые вызовы; расшифрование завершается только verify
+    printf("  Test %d: calls after final, final on a decryption stream\n", NUM_OF_TESTCASES_AES + 2);
+    if (aes256_gcm_stream_final(&stream, tag) == STATUS_OK ||
+        aes256_gcm_stream_verify(&stream, expected_tag) == STATUS_OK ||
+        aes256_gcm_stream_update(&stream, plaintext.data(), answer.data(), 16) == STATUS_OK ||
+        aes256_gcm_stream_aad(&stream, plaintext.data(), 16) == STATUS_OK) {
+        printf("    ERROR: finished encryption stream accepted another call\n");
+        return false;
+    }
+    
+    aes256_gcm_stream_init_decrypt(&stream, &ctx, iv);
+    aes256_gcm_stream_update(&stream, expected.data(), answer.data(), n);
+    if (aes256_gcm_stream_final(&stream, tag) == STATUS_OK) {
+        printf("    ERROR: aes256_gcm_stream_final accepted a decryption stream\n");
+        return false;
+    }
+    if (aes256_gcm_stream_verify(&stream, expected_tag) != STATUS_OK || answer != plaintext) {
+        printf("    ERROR: decryption stream failed to verify\n");
+        return false;
+    }
+    if (aes256_gcm_stream_verify(&stream, expected_tag) == STATUS_OK ||
+        aes256_gcm_stream_update(&stream, expected.data(), answer.data(), 16) == STATUS_OK) {
+        printf("    ERROR: finished decryption stream accepted another call\n");
+        return false;
+    }
+    printf("    OK\n");
+    
+    printf("test_aes256_gcm_stream: OK\n");
+    return true;
+}
+
+bool test_aes256_gcm_aad() {
+    printf("Running AES-256-GCM AAD tests...\n");
     
-    for (size_t i = 0; i < NUM_OF_TESTCASES_CRC32; ++i) {
-        printf("  Test %zu: \"%s\" (%zu bytes)\n", i + 1, 
-               testcases_crc32[i].input.empty() ? "(empty string)" : testcases_crc32[i].input.c_str(),
-               testcases_crc32[i].input.size());
+    for (size_t i = 0; i < NUM_OF_TESTCASES_AES_AAD; ++i) {
+        const TestCaseAESAAD& tc = testcases_aes_aad[i];
+        printf("  Test %zu: data size = %zu bytes, AAD size = %zu bytes\n", i + 1, tc.n, tc.aad.size());
+        
+        Aes256GcmContext ctx;
+        aes256_gcm_init(&ctx, tc.key.data());
         
-        uint32_t result;
-        Status status = crc32((const uint8_t*)(testcases_crc32[i].input.data()), 
-                             testcases_crc32[i].input.size(), &result);
+        std::vector<uint8_t> answer(tc.n + 1);
+        uint8_t tag[16];
         
+        Status status = aes256_gcm_encrypt_aad(&ctx, tc.plaintext.data(), answer.data(), tc.iv.data(), tc.n,
+                                               tc.aad.data(), tc.aad.size(), tag);
         if (status != STATUS_OK) {
-            printf("    ERROR: crc32 function returned status %d\n", status);
+            printf("    ERROR: aes256_gcm_encrypt_aad function returned status %d\n", status);
+            return false;
+        }
+        if (memcmp(answer.data(), tc.ciphertext.data(), tc.n) != 0 || memcmp(tag, tc.tag.data(), 16) != 0) {
+            printf("    ERROR: ciphertext or tag mismatch\n");
+            return false;
+        }
+        
+        // Тот же результат потоком: AAD, затем данные по 7 байт
+        Aes256GcmStream stream;
+        aes256_gcm_stream_init(&stream, &ctx, tc.iv.data());
+        aes256_gcm_stream_aad(&stream, tc.aad.data(), tc.aad.size());
+        for (size_t pos = 0; pos < tc.n; pos += 7) {
+            size_t len = (pos + 7 <= tc.n) ? 7 : tc.n - pos;
+            aes256_gcm_stream_update(&stream, tc.plaintext.data() + pos, answer.data() + pos, len);
+        }
+        aes256_gcm_stream_final(&stream, tag);
+        if (memcmp(answer.data(), tc.ciphertext.data(), tc.n) != 0 || memcmp(tag, tc.tag.data(), 16) != 0) {
+            printf("    ERROR: streaming ciphertext or tag mismatch\n");
+            return false;
+        }
+        
+        status = aes256_gcm_decrypt(&ctx, tc.ciphertext.data(), answer.data(), tc.iv.data(), tc.n,
+                                    tc.aad.data(), tc.aad.size(), tc.tag.data());
+        if (status != STATUS_OK || memcmp(answer.data(), tc.plaintext.data(), tc.n) != 0) {
+            printf("    ERROR: decryption failed, status %d\n", status);
             return false;
         }
         
-        if (result != testcases_crc32[i].result) {
-            printf("    ERROR: CRC32 mismatch\n");
-            printf("    Expected: 0x%08X, Got: 0x%08X\n", 
-                   testcases_crc32[i].result, result);
+        // Изменённые AAD должны отвергаться
+        std::vector<uint8_t> bad_aad(tc.aad);
+        bad_aad[bad_aad.size() - 1] ^= 0x01;
+        status = aes256_gcm_decrypt(&ctx, tc.ciphertext.data(), answer.data(), tc.iv.data(), tc.n,
+                                    bad_aad.data(), bad_aad.size(), tc.tag.data());
+        if (status == STATUS_OK) {
+            printf("    ERROR: modified AAD accepted\n");
             return false;
         }
         
-        printf("    OK (CRC32: 0x%08X)\n", result);
+        printf("    OK\n");
+    }
+    
+    printf("test_aes256_gcm_aad: OK\n");
+    return true;
+}
+
+bool test_aes256_gcm_decrypt() {
+    printf("Running AES-256-GCM decryption tests...\n");
+    
+    for (size_t i = 0; i < NUM_OF_TESTCASES_AES; ++i) {
+        printf("  Test %zu: data size = %zu bytes\n", i + 1, testcases_aes[i].n);
+        
+        Aes256GcmContext ctx;
+        aes256_gcm_init(&ctx, testcases_aes[i].key.data());
+        
+        std::vector<uint8_t> answer(testcases_aes[i].n);
+        Status status = aes256_gcm_decrypt(&ctx, testcases_aes[i].ciphertext.data(), answer.data(),
+                                           testcases_aes[i].iv.data(), testcases_aes[i].n,
+                                           nullptr, 0, testcases_aes[i].tag.data());
+        if (status != STATUS_OK || memcmp(answer.data(), testcases_aes[i].plaintext.data(), testcases_aes[i].n) != 0) {
+            printf("    ERROR: decryption failed, status %d\n", status);
+            return false;
+        }
+        
+        // Любой изменённый бит тега или шифртекста - отказ и обнулённый выход
+        std::vector<uint8_t> bad_tag(testcases_aes[i].tag);
+        bad_tag[i % 16] ^= 0x80;
+        std::vector<uint8_t> bad_ciphertext(testcases_aes[i].ciphertext);
+        bad_ciphertext[testcases_aes[i].n - 1] ^= 0x01;
+        
+        status = aes256_gcm_decrypt(&ctx, testcases_aes[i].ciphertext.data(), answer.data(),
+                                    testcases_aes[i].iv.data(), testcases_aes[i].n, nullptr, 0, bad_tag.data());
+        if (status == STATUS_OK) {
+            printf("    ERROR: modified tag accepted\n");
+            return false;
+        }
+        for (size_t j = 0; j < testcases_aes[i].n; j++) {
+            if (answer[j] != 0) {
+                printf("    ERROR: plaintext not cleared after failed verification\n");
+                return false;
+            }
+        }
+        
+        status = aes256_gcm_decrypt(&ctx, bad_ciphertext.data(), answer.data(),
+                                    testcases_aes[i].iv.data(), testcases_aes[i].n, nullptr, 0, testcases_aes[i].tag.data());
+        if (status == STATUS_OK) {
+            printf("    ERROR: modified ciphertext accepted\n");
+            return false;
+        }
+        
+        printf("    OK\n");
+    }
+    
+    printf("test_aes256_gcm_decrypt: OK\n");
+    return true;
+}
+
+// Потоков больше, чем 16-КБ плиток: нулевой поток без плиток всё равно переносит
+// входное состояние GHASH (хеш AAD или предыдущих update). Число потоков задаётся
+// явно, чтобы путь проверялся и на машинах с малым числом ядер
+bool test_aes256_gcm_threads() {
+    printf("Running AES-256-GCM tests with more threads than tiles...\n");
+    
+    const size_t sizes[] = {64 * 1024, 72 * 1024 + 5, 80 * 1024};
+    const int saved_threads = omp_get_max_threads();
+    
+    Aes256GcmContext ctx;
+    aes256_gcm_init(&ctx, testcases_aes_aad[0].key.data());
+    const uint8_t* iv = testcases_aes_aad[0].iv.data();
+    const std::vector<uint8_t>& aad = testcases_aes_aad[0].aad;
+    
+    std::mt19937 gen(7);
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]) && ok; ++i) {
+        const size_t n = sizes[i];
+        printf("  Test %zu: data size = %zu bytes, 8 threads\n", i + 1, n);
+        
+        std::vector<uint8_t> plaintext(n), expected(n), answer(n);
+        for (size_t j = 0; j < n; j++) {
+            plaintext[j] = (uint8_t)gen();
+        }
+        const size_t head = 1 + gen() % 100;
+        
+        // Эталон на одном потоке: AAD + данные и поток с коротким первым update
+        omp_set_num_threads(1);
+        uint8_t expected_tag[16], expected_stream_tag[16], tag[16];
+        aes256_gcm_encrypt_aad(&ctx, plaintext.data(), expected.data(), iv, n, aad.data(), aad.size(), expected_tag);
+        
+        Aes256GcmStream stream;
+        aes256_gcm_stream_init(&stream, &ctx, iv);
+        aes256_gcm_stream_update(&stream, plaintext.data(), answer.data(), head);
+        aes256_gcm_stream_update(&stream, plaintext.data() + head, answer.data() + head, n - head);
+        aes256_gcm_stream_final(&stream, expected_stream_tag);
+        
+        omp_set_num_threads(8);
+        aes256_gcm_encrypt_aad(&ctx, plaintext.data(), answer.data(), iv, n, aad.data(), aad.size(), tag);
+        if (answer != expected || memcmp(tag, expected_tag, 16) != 0) {
+            printf("    ERROR: ciphertext or tag with AAD differs from single-threaded run\n");
+            ok = false;
+            break;
+        }
+        
+        std::vector<uint8_t> decrypted(n);
+        if (aes256_gcm_decrypt(&ctx, expected.data(), decrypted.data(), iv, n, aad.data(), aad.size(),
+                               expected_tag) != STATUS_OK || decrypted != plaintext) {
+            printf("    ERROR: decryption with AAD failed\n");
+            ok = false;
+            break;
+        }
+        
+        // Большой update после короткого: состояние GHASH уже не нулевое
+        aes256_gcm_stream_init(&stream, &ctx, iv);
+        aes256_gcm_stream_update(&stream, plaintext.data(), answer.data(), head);
+        aes256_gcm_stream_update(&stream, plaintext.data() + head, answer.data() + head, n - head);
+        aes256_gcm_stream_final(&stream, tag);
+        if (memcmp(tag, expected_stream_tag, 16) != 0) {
+            printf("    ERROR: stream tag after a prior update differs from single-threaded run\n");
+            ok = false;
+            break;
+        }
+        
+        printf("    OK\n");
+    }
+    
+    omp_set_num_threads(saved_threads);
+    if (!ok) {
+        return false;
+    }
+    
+    printf("test_aes256_gcm_threads: OK\n");
+    return true;
+}
+
+// Шифрование на месте совпадает с шифрованием в отдельный буфер, в том числе
+// на многопоточном пути; частично перекрытые буферы отвергаются
+bool test_aes256_gcm_inplace() {
+    printf("Running AES-256-GCM in-place tests...\n");
+    
+    for (size_t i = 0; i < NUM_OF_TESTCASES_AES; ++i) {
+        printf("  Test %zu: data size = %zu bytes\n", i + 1, testcases_aes[i].n);
+        
+        Aes256GcmContext ctx;
+        aes256_gcm_init(&ctx, testcases_aes[i].key.data());
+        
+        std::vector<uint8_t> data(testcases_aes[i].plaintext);
+        uint8_t tag[16];
+        Status status = aes256_gcm_encrypt_inplace(&ctx, data.data(), testcases_aes[i].iv.data(),
+                                                   testcases_aes[i].n, nullptr, 0, tag);
+        if (status != STATUS_OK || memcmp(data.data(), testcases_aes[i].ciphertext.data(), testcases_aes[i].n) != 0 ||
+            memcmp(tag, testcases_aes[i].tag.data(), 16) != 0) {
+            printf("    ERROR: aes256_gcm_encrypt_inplace mismatch, status %d\n", status);
+            return false;
+        }
+        
+        data = testcases_aes[i].plaintext;
+        status = aes256_gcm(data.data(), data.data(), testcases_aes[i].key.data(), testcases_aes[i].iv.data(),
+                            testcases_aes[i].n, tag);
+        if (status != STATUS_OK || memcmp(data.data(), testcases_aes[i].ciphertext.data(), testcases_aes[i].n) != 0 ||
+            memcmp(tag, testcases_aes[i].tag.data(), 16) != 0) {
+            printf("    ERROR: aes256_gcm with plaintext == ciphertext mismatch, status %d\n", status);
+            return false;
+        }
+        
+        printf("    OK\n");
+    }
+    
+    printf("  Large buffer\n");
+    const size_t n = 1024 * 1024 + 7;
+    std::mt19937 gen(5);
+    std::vector<uint8_t> key(32), iv(12), aad(29);
+    std::vector<uint8_t> plaintext(n + 32), expected(n), data;
+    for (size_t j = 0; j < key.size(); j++) key[j] = (uint8_t)gen();
+    for (size_t j = 0; j < iv.size(); j++) iv[j] = (uint8_t)gen();
+    for (size_t j = 0; j < aad.size(); j++) aad[j] = (uint8_t)gen();
+    for (size_t j = 0; j < plaintext.size(); j++) plaintext[j] = (uint8_t)gen();
+    
+    Aes256GcmContext ctx;
+    aes256_gcm_init(&ctx, key.data());
+    uint8_t expected_tag[16], tag[16];
+    aes256_gcm_encrypt_aad(&ctx, plaintext.data(), expected.data(), iv.data(), n, aad.data(), aad.size(), expected_tag);
+    
+    data.assign(plaintext.begin(), plaintext.begin() + n);
+    aes256_gcm_encrypt_inplace(&ctx, data.data(), iv.data(), n, aad.data(), aad.size(), tag);
+    if (data != expected || memcmp(tag, expected_tag, 16) != 0) {
+        printf("    ERROR: in-place result differs from out-of-place\n");
+        return false;
+    }
+    
+    if (aes256_gcm_decrypt(&ctx, data.data(), data.data(), iv.data(), n, aad.data(), aad.size(), tag) != STATUS_OK ||
+        memcmp(data.data(), plaintext.data(), n) != 0) {
+        printf("    ERROR: in-place decryption failed\n");
+        return false;
+    }
+    
+    // Выход сдвинут относительно входа внутри одного буфера
+    const size_t shifts[] = {1, 16, 4096};
+    for (size_t k = 0; k < sizeof(shifts) / sizeof(shifts[0]); k++) {
+        uint8_t *p = plaintext.data();
+        if (aes256_gcm_encrypt(&ctx, p, p + shifts[k], iv.data(), n - shifts[k], tag) == STATUS_OK ||
+            aes256_gcm_encrypt(&ctx, p + shifts[k], p, iv.data(), n - shifts[k], tag) == STATUS_OK ||
+            aes256_gcm_decrypt(&ctx, p, p + shifts[k], iv.data(), 64, nullptr, 0, tag) == STATUS_OK) {
+            printf("    ERROR: partially overlapping buffers accepted (shift %zu)\n", shifts[k]);
+            return false;
+        }
+    }
+    
+    // Соседние непересекающиеся куски одного буфера допустимы
+    if (aes256_gcm_encrypt(&ctx, plaintext.data(), plaintext.data() + 64, iv.data(), 64, tag) != STATUS_OK) {
+        printf("    ERROR: adjacent buffers rejected\n");
+        return false;
+    }
+    
+    printf("    OK\n");
+    printf("test_aes256_gcm_inplace: OK\n");
+    return true;
+}
+
+// Сравнивает батч с поштучными вызовами aes256_gcm на текущей реализации AES
+static bool check_aes_batch() {
+    const size_t lens[] = {0, 1, 15, 16, 17, 64, 100, 511, 512, 513, 1500, 5000};
+    const size_t num_lens = sizeof(lens) / sizeof(lens[0]);
+    const size_t count = 100;
+    
+    std::mt19937 gen(7);
+    std::vector<std::vector<uint8_t> > keys(count, std::vector<uint8_t>(32));
+    std::vector<std::vector<uint8_t> > ivs(count, std::vector<uint8_t>(12));
+    std::vector<std::vector<uint8_t> > plaintexts(count), ciphertexts(count), expected(count);
+    std::vector<std::vector<uint8_t> > tags(count, std::vector<uint8_t>(16));
+    std::vector<Aes256GcmBatchEntry> entries(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        // Серии записей с одинаковым ключом и одиночные ключи вперемешку
+        if (i % 5 == 0) {
+            for (size_t j = 0; j < 32; j++) {
+                keys[i][j] = (uint8_t)gen();
+            }
+        } else {
+            keys[i] = keys[i - 1];
+        }
+        for (size_t j = 0; j < 12; j++) {
+            ivs[i][j] = (uint8_t)gen();
+        }
+        
+        size_t len = lens[(i * 7) % num_lens];
+        plaintexts[i].resize(len + 1);
+        ciphertexts[i].resize(len + 1);
+        expected[i].resize(len + 1);
+        for (size_t j = 0; j < len; j++) {
+            plaintexts[i][j] = (uint8_t)gen();
+        }
+        
+        Aes256GcmBatchEntry e = {keys[i].data(), ivs[i].data(), plaintexts[i].data(),
+                                 ciphertexts[i].data(), len, tags[i].data()};
+        entries[i] = e;
+    }
+    
+    Status status = aes256_gcm_encrypt_batch(entries.data(), count);
+    if (status != STATUS_OK) {
+        printf("    ERROR: aes256_gcm_encrypt_batch function returned status %d\n", status);
+        return false;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        uint8_t tag[16];
+        aes256_gcm(plaintexts[i].data(), expected[i].data(), keys[i].data(), ivs[i].data(), entries[i].len, tag);
+        if (memcmp(expected[i].data(), ciphertexts[i].data(), entries[i].len) != 0 ||
+            memcmp(tag, tags[i].data(), 16) != 0) {
+            printf("    ERROR: entry %zu (%zu bytes) differs from aes256_gcm\n", i, entries[i].len);
+            return false;
+        }
+    }
+    
+    // Некорректная запись отвергает весь батч
+    entries[count / 2].tag = nullptr;
+    if (aes256_gcm_encrypt_batch(entries.data(), count) == STATUS_OK) {
+        printf("    ERROR: batch with a null tag pointer accepted\n");
+        return false;
+    }
+    
+    return true;
+}
+
+bool test_aes256_gcm_batch() {
+    printf("Running AES-256-GCM batch tests...\n");
+    
+    printf("  Default backend\n");
+    if (!check_aes_batch()) {
+        return false;
+    }
+    
+    printf("  Bitsliced backend\n");
+    aes256_set_backend(AES_BACKEND_BITSLICED);
+    bool ok = check_aes_batch();
+    aes256_set_backend(AES_BACKEND_AUTO);
+    if (!ok) {
+        return false;
+    }
+    
+    printf("test_aes256_gcm_batch: OK\n");
+    return true;
+}
+
+// FIPS-197, приложение C.3, и большой буфер (многопоточный путь), сверенный
+// с побайтовой реализацией
+// Режет buf на сегменты случайной длины от 0 до max_len байт
+static std::vector<Aes256GcmIovec> split_segments(uint8_t* buf, size_t len, size_t max_len, std::mt19937& gen) {
+    std::vector<Aes256GcmIovec> segments;
+    size_t pos = 0;
+    while (pos < len) {
+        size_t n = gen() % (max_len + 1);
+        if (n > len - pos) {
+            n = len - pos;
+        }
+        Aes256GcmIovec seg = {buf + pos, n};
+        segments.push_back(seg);
+        pos += n;
+    }
+    return segments;
+}
+
+bool test_aes256_gcm_iov() {
+    printf("Running AES-256-GCM scatter-gather tests...\n");
+    std::mt19937 gen(29);
+    
+    for (size_t i = 0; i < NUM_OF_TESTCASES_AES_AAD; ++i) {
+        const TestCaseAESAAD& tc = testcases_aes_aad[i];
+        printf("  Test %zu: data size = %zu bytes, AAD size = %zu bytes\n", i + 1, tc.n, tc.aad.size());
+        
+        Aes256GcmContext ctx;
+        aes256_gcm_init(&ctx, tc.key.data());
+        
+        // AAD по байту, данные - разной нарезкой на входе и выходе
+        std::vector<uint8_t> aad(tc.aad), plaintext(tc.plaintext), answer(tc.n);
+        std::vector<Aes256GcmIovec> aad_iov = split_segments(aad.data(), aad.size(), 1, gen);
+        std::vector<Aes256GcmIovec> in_iov = split_segments(plaintext.data(), tc.n, 7, gen);
+        std::vector<Aes256GcmIovec> out_iov = split_segments(answer.data(), tc.n, 5, gen);
+        uint8_t tag[16];
+        Status status = aes256_gcm_encrypt_iov(&ctx, tc.iv.data(), aad_iov.data(), aad_iov.size(), in_iov.data(),
+                                               in_iov.size(), out_iov.data(), out_iov.size(), tag);
+        if (status != STATUS_OK || memcmp(answer.data(), tc.ciphertext.data(), tc.n) != 0 ||
+            memcmp(tag, tc.tag.data(), 16) != 0) {
+            printf("    ERROR: ciphertext or tag mismatch, status %d\n", status);
+            return false;
+        }
+        printf("    OK\n");
+    }
+    
+    const size_t n = 1024 * 1024 + 37;
+    printf("  Test %d: data size = %zu bytes, random segments\n", NUM_OF_TESTCASES_AES_AAD + 1, n);
+    
+    uint8_t key[32], iv[12];
+    for (int i = 0; i < 32; i++) {
+        key[i] = (uint8_t)gen();
+    }
+    for (int i = 0; i < 12; i++) {
+        iv[i] = (uint8_t)gen();
     }
+    Aes256GcmContext ctx;
+    aes256_gcm_init(&ctx, key);
     
+    std::vector<uint8_t> plaintext(n), aad(1000), reference(n), ciphertext(n), decrypted(n);
+    for (size_t i = 0; i < n; i++) {
+        plaintext[i] = (uint8_t)gen();
+    }
+    for (size_t i = 0; i < aad.size(); i++) {
+        aad[i] = (uint8_t)gen();
+    }
+    uint8_t reference_tag[16], tag[16];
+    aes256_gcm_encrypt_aad(&ctx, plaintext.data(), reference.data(), iv, n, aad.data(), aad.size(), reference_tag);
+    
+    std::vector<Aes256GcmIovec> aad_iov = split_segments(aad.data(), aad.size(), 100, gen);
+    std::vector<Aes256GcmIovec> in_iov = split_segments(plaintext.data(), n, 200000, gen);
+    std::vector<Aes256GcmIovec> out_iov = split_segments(ciphertext.data(), n, 300000, gen);
+    if (aes256_gcm_encrypt_iov(&ctx, iv, aad_iov.data(), aad_iov.size(), in_iov.data(), in_iov.size(),
+                               out_iov.data(), out_iov.size(), tag) != STATUS_OK ||
+        ciphertext != reference || memcmp(tag, reference_tag, 16) != 0) {
+        printf("    ERROR: result differs from aes256_gcm_encrypt_aad\n");
+        return false;
+    }
+    
+    in_iov = split_segments(ciphertext.data(), n, 1500, gen);
+    out_iov = split_segments(decrypted.data(), n, 100000, gen);
+    if (aes256_gcm_decrypt_iov(&ctx, iv, aad_iov.data(), aad_iov.size(), in_iov.data(), in_iov.size(),
+                               out_iov.data(), out_iov.size(), reference_tag) != STATUS_OK || decrypted != plaintext) {
+        printf("    ERROR: decryption mismatch\n");
+        return false;
+    }
+    
+    out_iov.back().len -= 1;
+    if (aes256_gcm_encrypt_iov(&ctx, iv, aad_iov.data(), aad_iov.size(), in_iov.data(), in_iov.size(),
+                               out_iov.data(), out_iov.size(), tag) == STATUS_OK) {
+        printf("    ERROR: segment lists of different lengths accepted\n");
+        return false;
+    }
+    out_iov.back().len += 1;
+    
+    reference_tag[0] ^= 1;
+    if (aes256_gcm_decrypt_iov(&ctx, iv, aad_iov.data(), aad_iov.size(), in_iov.data(), in_iov.size(),
+                               out_iov.data(), out_iov.size(), reference_tag) == STATUS_OK ||
+        std::count(decrypted.begin(), decrypted.end(), 0) != (long)n) {
+        printf("    ERROR: forged tag accepted or plaintext not wiped\n");
+        return false;
+    }
+    printf("    OK (%zu input segments)\n", in_iov.size());
+    
+    printf("test_aes256_gcm_iov: OK\n");
+    return true;
+}
+
+bool test_aes256_gcm_chunked() {
+    printf("Running chunked AES-256-GCM container tests...\n");
+    
+    uint8_t key[32], prefix[7];
+    for (int i = 0; i < 32; i++) {
+        key[i] = (uint8_t)(0x40 + i);
+    }
+    for (int i = 0; i < 7; i++) {
+        prefix[i] = (uint8_t)(0xC0 + i);
+    }
+    Aes256GcmContext ctx;
+    aes256_gcm_init(&ctx, key);
+    
+    const uint32_t chunk_size = 64 * 1024;
+    const size_t sizes[] = {0, 1000, 3 * chunk_size, 1024 * 1024 + 5};
+    std::mt19937 gen(23);
+    
+    for (size_t t = 0; t < sizeof(sizes) / sizeof(sizes[0]); ++t) {
+        size_t n = sizes[t];
+        printf("  Test %zu: data size = %zu bytes\n", t + 1, n);
+        
+        std::vector<uint8_t> plaintext(n);
+        for (size_t i = 0; i < n; i++) {
+            plaintext[i] = (uint8_t)gen();
+        }
+        
+        Aes256GcmChunked writer;
+        uint8_t header[AES256_GCM_CHUNKED_HEADER_LEN];
+        aes256_gcm_chunked_writer_init(&writer, &ctx, prefix, chunk_size, header);
+        size_t num_chunks = (n == 0) ? 1 : (n + chunk_size - 1) / chunk_size;
+        size_t container_len = aes256_gcm_chunked_size(&writer, n);
+        if (container_len != AES256_GCM_CHUNKED_HEADER_LEN + n + 16 * num_chunks) {
+            printf("    ERROR: unexpected container size %zu\n", container_len);
+            return false;
+        }
+        
+        std::vector<uint8_t> container(container_len), streamed(container_len);
+        if (aes256_gcm_chunked_encrypt(&writer, plaintext.data(), n, container.data()) != STATUS_OK) {
+            printf("    ERROR: aes256_gcm_chunked_encrypt failed\n");
+            return false;
+        }
+        
+        // Потоковая запись по чанкам даёт тот же контейнер
+        memcpy(streamed.data(), header, AES256_GCM_CHUNKED_HEADER_LEN);
+        for (size_t i = 0; i < num_chunks; i++) {
+            size_t start = i * chunk_size;
+            size_t len = (n - start < chunk_size) ? n - start : chunk_size;
+            aes256_gcm_chunked_write(&writer, i, i == num_chunks - 1, plaintext.data() + start, len,
+                                     streamed.data() + AES256_GCM_CHUNKED_HEADER_LEN + i * (chunk_size + 16));
+        }
+        if (streamed != container) {
+            printf("    ERROR: streamed container differs from aes256_gcm_chunked_encrypt\n");
+            return false;
+        }
+        
+        // Чанк - обычное сообщение GCM: nonce = prefix || номер || флаг, AAD = заголовок
+        uint8_t nonce[12] = {0};
+        memcpy(nonce, prefix, 7);
+        nonce[11] = (num_chunks == 1) ? 1 : 0;
+        size_t first_len = (n < chunk_size) ? n : chunk_size;
+        std::vector<uint8_t> expected(first_len + 16);
+        aes256_gcm_encrypt_aad(&ctx, plaintext.data(), expected.data(), nonce, first_len, header,
+                               AES256_GCM_CHUNKED_HEADER_LEN, expected.data() + first_len);
+        if (memcmp(container.data() + AES256_GCM_CHUNKED_HEADER_LEN, expected.data(), first_len + 16) != 0) {
+            printf("    ERROR: first record is not the expected GCM message\n");
+            return false;
+        }
+        
+        std::vector<uint8_t> decrypted(container_len);
+        size_t decrypted_len = 0;
+        if (aes256_gcm_chunked_decrypt(&ctx, container.data(), container_len, decrypted.data(), &decrypted_len) != STATUS_OK ||
+            decrypted_len != n || memcmp(decrypted.data(), plaintext.data(), n) != 0) {
+            printf("    ERROR: aes256_gcm_chunked_decrypt mismatch\n");
+            return false;
+        }
+        
+        // Произвольный доступ, от последнего чанка к первому
+        Aes256GcmChunked reader;
+        if (aes256_gcm_chunked_reader_init(&reader, &ctx, container.data()) != STATUS_OK) {
+            printf("    ERROR: header rejected\n");
+            return false;
+        }
+        std::vector<uint8_t> chunk(chunk_size);
+        for (size_t i = num_chunks; i-- > 0;) {
+            size_t len = 0;
+            size_t start = i * chunk_size;
+            if (aes256_gcm_chunked_read_at(&reader, container.data(), container_len, i, chunk.data(), &len) != STATUS_OK ||
+                len != ((n - start < chunk_size) ? n - start : chunk_size) ||
+                memcmp(chunk.data(), plaintext.data() + start, len) != 0) {
+                printf("    ERROR: random read of chunk %zu failed\n", i);
+                return false;
+            }
+        }
+        
+        if (num_chunks >= 3) {
+            // Подмена байта ломает только свой чанк
+            std::vector<uint8_t> tampered(container);
+            size_t record = chunk_size + 16;
+            tampered[AES256_GCM_CHUNKED_HEADER_LEN + record + 7] ^= 1;
+            size_t len = 0;
+            if (aes256_gcm_chunked_decrypt(&ctx, tampered.data(), container_len, decrypted.data(), &decrypted_len) == STATUS_OK ||
+                std::count(decrypted.begin(), decrypted.begin() + n, 0) != (long)n) {
+                printf("    ERROR: tampered container accepted or plaintext not wiped\n");
+                return false;
+            }
+            if (aes256_gcm_chunked_read_at(&reader, tampered.data(), container_len, 1, chunk.data(), &len) == STATUS_OK ||
+                aes256_gcm_chunked_read_at(&reader, tampered.data(), container_len, 2, chunk.data(), &len) != STATUS_OK) {
+                printf("    ERROR: tampering not isolated to its chunk\n");
+                return false;
+            }
+            
+            // Переставленные чанки и обрезанный по границе записи контейнер
+            tampered = container;
+            std::swap_ranges(tampered.begin() + AES256_GCM_CHUNKED_HEADER_LEN,
+                             tampered.begin() + AES256_GCM_CHUNKED_HEADER_LEN + record,
+                             tampered.begin() + AES256_GCM_CHUNKED_HEADER_LEN + record);
+            if (aes256_gcm_chunked_decrypt(&ctx, tampered.data(), container_len, decrypted.data(), &decrypted_len) == STATUS_OK) {
+                printf("    ERROR: reordered chunks accepted\n");
+                return false;
+            }
+            if (aes256_gcm_chunked_decrypt(&ctx, container.data(), AES256_GCM_CHUNKED_HEADER_LEN + 2 * record,
+                                           decrypted.data(), &decrypted_len) == STATUS_OK) {
+                printf("    ERROR: truncated container accepted\n");
+                return false;
+            }
+        }
+        
+        printf("    OK (%zu chunks)\n", num_chunks);
+    }
+    
+    printf("test_aes256_gcm_chunked: OK\n");
+    return true;
+}
+
+bool test_aes256_ecb() {
+    printf("Running AES-256-ECB tests...\n");
+    
+    uint8_t key[32], block[16];
+    for (int i = 0; i < 32; i++) {
+        key[i] = (uint8_t)i;
+    }
+    for (int i = 0; i < 16; i++) {
+        block[i] = (uint8_t)(i * 0x11);
+    }
+    const uint8_t expected_block[16] = {0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+                                        0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89};
+    
+    const size_t n = 1024 * 1024 + 48;
+    std::mt19937 gen(11);
+    std::vector<uint8_t> plaintext(n), reference(n), ciphertext(n), decrypted(n);
+    for (size_t i = 0; i < n; i++) {
+        plaintext[i] = (uint8_t)gen();
+    }
+    
+    const AesBackend aes_backends[] = {AES_BACKEND_BYTEWISE, AES_BACKEND_TTABLE, AES_BACKEND_BITSLICED, AES_BACKEND_AESNI,
+                                       AES_BACKEND_VAES};
+    const char* aes_names[] = {"bytewise", "ttable", "bitsliced", "aesni", "vaes"};
+    bool ok = true;
+    
+    for (size_t a = 0; a < sizeof(aes_backends) / sizeof(aes_backends[0]) && ok; ++a) {
+        if (aes256_set_backend(aes_backends[a]) != STATUS_OK) {
+            printf("  %s: not supported on this CPU, skipped\n", aes_names[a]);
+            continue;
+        }
+        printf("  %s\n", aes_names[a]);
+        ok = false;
+        
+        Aes256EcbContext ctx;
+        aes256_ecb_init(&ctx, key);
+        
+        uint8_t out[16], back[16];
+        if (aes256_ecb_encrypt(&ctx, block, out, 16) != STATUS_OK || memcmp(out, expected_block, 16) != 0) {
+            printf("    ERROR: FIPS-197 ciphertext mismatch\n");
+            break;
+        }
+        if (aes256_ecb_decrypt(&ctx, out, back, 16) != STATUS_OK || memcmp(back, block, 16) != 0) {
+            printf("    ERROR: FIPS-197 decryption mismatch\n");
+            break;
+        }
+        
+        std::vector<uint8_t>& target = (a == 0) ? reference : ciphertext;
+        aes256_ecb_encrypt(&ctx, plaintext.data(), target.data(), n);
+        if (a != 0 && ciphertext != reference) {
+            printf("    ERROR: ciphertext differs from bytewise backend\n");
+            break;
+        }
+        
+        // Расшифрование на месте
+        decrypted = target;
+        aes256_ecb_decrypt(&ctx, decrypted.data(), decrypted.data(), n);
+        if (decrypted != plaintext) {
+            printf("    ERROR: round trip mismatch\n");
+            break;
+        }
+        
+        if (aes256_ecb_encrypt(&ctx, plaintext.data(), ciphertext.data(), 17) == STATUS_OK) {
+            printf("    ERROR: length not multiple of 16 accepted\n");
+            break;
+        }
+        
+        printf("    OK\n");
+        ok = true;
+    }
+    
+    aes256_set_backend(AES_BACKEND_AUTO);
+    
+    if (!ok) {
+        return false;
+    }
+    
+    printf("test_aes256_ecb: OK\n");
+    return true;
+}
+
+bool test_aes256_ctr_drbg() {
+    printf("Running AES-256 CTR_DRBG tests...\n");
+    
+    // CAVP CTR_DRBG AES-256 no df, без доп. входа: Generate дважды, проверяется второй выход
+    const uint8_t cavp_entropy[48] = {
+        0xdf, 0x5d, 0x73, 0xfa, 0xa4, 0x68, 0x64, 0x9e, 0xdd, 0xa3, 0x3b, 0x5c,
+        0xca, 0x79, 0xb0, 0xb0, 0x56, 0x00, 0x41, 0x9c, 0xcb, 0x7a, 0x87, 0x9d,
+        0xdf, 0xec, 0x9d, 0xb3, 0x2e, 0xe4, 0x94, 0xe5, 0x53, 0x1b, 0x51, 0xde,
+        0x16, 0xa3, 0x0f, 0x76, 0x92, 0x62, 0x47, 0x4c, 0x73, 0xbe, 0xc0, 0x10};
+    const uint8_t cavp_expected[64] = {
+        0xd1, 0xc0, 0x7c, 0xd9, 0x5a, 0xf8, 0xa7, 0xf1, 0x10, 0x12, 0xc8, 0x4c,
+        0xe4, 0x8b, 0xb8, 0xcb, 0x87, 0x18, 0x9e, 0x99, 0xd4, 0x0f, 0xcc, 0xb1,
+        0x77, 0x1c, 0x61, 0x9b, 0xdf, 0x82, 0xab, 0x22, 0x80, 0xb1, 0xdc, 0x2f,
+        0x25, 0x81, 0xf3, 0x91, 0x64, 0xf7, 0xac, 0x0c, 0x51, 0x04, 0x94, 0xb3,
+        0xa4, 0x3c, 0x41, 0xb7, 0xdb, 0x17, 0x51, 0x4c, 0x87, 0xb1, 0x07, 0xae,
+        0x79, 0x3e, 0x01, 0xc5};
+    
+    // Персонализация, доп. вход и reseed; ожидаемые значения посчитаны по SP 800-90A
+    // независимой реализацией поверх AES из OpenSSL
+    uint8_t entropy[48], entropy2[48], personalization[20], additional[48], additional2[16];
+    for (int i = 0; i < 48; i++) {
+        entropy[i] = (uint8_t)i;
+        entropy2[i] = (uint8_t)(0xa0 + i);
+        additional[i] = (uint8_t)(0x40 + i);
+    }
+    for (int i = 0; i < 20; i++) {
+        personalization[i] = (uint8_t)(0x80 + i);
+    }
+    memset(additional2, 0x11, sizeof(additional2));
+    const uint8_t expected_first[32] = {
+        0xd5, 0x64, 0xdd, 0xee, 0x60, 0x8e, 0x2c, 0xc5, 0x98, 0x11, 0x9b, 0x81,
+        0x71, 0xaa, 0x4a, 0x82, 0x54, 0xad, 0xfb, 0xbd, 0x48, 0x89, 0xc5, 0xb3,
+        0x52, 0xc7, 0xe0, 0x84, 0x6d, 0x0a, 0x81, 0x1e};
+    const uint8_t expected_reseeded[80] = {
+        0x05, 0x1b, 0x85, 0xab, 0x73, 0x59, 0xfe, 0x0d, 0x8c, 0x8d, 0xe7, 0x3a,
+        0xba, 0x81, 0x93, 0xeb, 0x3b, 0x3d, 0x5c, 0x59, 0x56, 0xa2, 0xde, 0xf9,
+        0xcd, 0x65, 0xef, 0xb3, 0x3c, 0x00, 0x7f, 0x8d, 0xa2, 0x1b, 0x60, 0x0f,
+        0x1b, 0xe2, 0x2b, 0xa4, 0x19, 0xe7, 0xfc, 0xf6, 0x58, 0x83, 0x5b, 0x91,
+        0x94, 0xf4, 0xee, 0x9a, 0x93, 0x8c, 0x10, 0xfc, 0x5f, 0xf5, 0x8e, 0xe5,
+        0x46, 0x86, 0x75, 0xcd, 0x7d, 0x01, 0x47, 0x6f, 0x1f, 0xfa, 0xa5, 0x8d,
+        0x64, 0x96, 0x80, 0xa7, 0xe6, 0xf6, 0xc0, 0xe9};
+    // Последние 16 байт из 300000, сгенерированных одним вызовом с доп. входом
+    const uint8_t expected_long_tail[16] = {
+        0x5e, 0x4f, 0x2f, 0xc8, 0xec, 0x02, 0xd5, 0x8b, 0xea, 0xca, 0xb8, 0x77, 0x05, 0x03, 0x66, 0xa7};
+    
+    const size_t n = 300000;
+    std::vector<uint8_t> whole(n), pieces(n);
+    
+    const AesBackend aes_backends[] = {AES_BACKEND_BYTEWISE, AES_BACKEND_TTABLE, AES_BACKEND_BITSLICED, AES_BACKEND_AESNI,
+                                       AES_BACKEND_VAES};
+    const char* aes_names[] = {"bytewise", "ttable", "bitsliced", "aesni", "vaes"};
+    bool ok = true;
+    
+    for (size_t a = 0; a < sizeof(aes_backends) / sizeof(aes_backends[0]) && ok; ++a) {
+        if (aes256_set_backend(aes_backends[a]) != STATUS_OK) {
+            printf("  %s: not supported on this CPU, skipped\n", aes_names[a]);
+            continue;
+        }
+        printf("  %s\n", aes_names[a]);
+        ok = false;
+        
+        Aes256CtrDrbg drbg;
+        uint8_t out[80];
+        aes256_ctr_drbg_init(&drbg, cavp_entropy, nullptr, 0);
+        aes256_ctr_drbg_generate(&drbg, out, 64, nullptr, 0);
+        if (aes256_ctr_drbg_generate(&drbg, out, 64, nullptr, 0) != STATUS_OK || memcmp(out, cavp_expected, 64) != 0) {
+            printf("    ERROR: CAVP vector mismatch\n");
+            break;
+        }
+        
+        aes256_ctr_drbg_init(&drbg, entropy, personalization, sizeof(personalization));
+        if (aes256_ctr_drbg_generate(&drbg, out, 32, additional, sizeof(additional)) != STATUS_OK ||
+            memcmp(out, expected_first, 32) != 0) {
+            printf("    ERROR: output with personalization and additional input mismatch\n");
+            break;
+        }
+        aes256_ctr_drbg_reseed(&drbg, entropy2, additional2, sizeof(additional2));
+        if (aes256_ctr_drbg_generate(&drbg, out, 80, nullptr, 0) != STATUS_OK ||
+            memcmp(out, expected_reseeded, 80) != 0) {
+            printf("    ERROR: output after reseed mismatch\n");
+            break;
+        }
+        
+        // Длинный вызов - это последовательность запросов по 64 КБ
+        aes256_ctr_drbg_init(&drbg, entropy, nullptr, 0);
+        aes256_ctr_drbg_generate(&drbg, whole.data(), n, additional, sizeof(additional));
+        aes256_ctr_drbg_init(&drbg, entropy, nullptr, 0);
+        for (size_t off = 0; off < n; off += 65536) {
+            size_t len = (n - off < 65536) ? n - off : 65536;
+            aes256_ctr_drbg_generate(&drbg, pieces.data() + off, len,
+                                     off == 0 ? additional : nullptr, off == 0 ? sizeof(additional) : 0);
+        }
+        if (whole != pieces || memcmp(whole.data() + n - 16, expected_long_tail, 16) != 0) {
+            printf("    ERROR: long request differs from 64 KB requests\n");
+            break;
+        }
+        
+        if (aes256_ctr_drbg_generate(&drbg, out, 16, additional, 49) == STATUS_OK) {
+            printf("    ERROR: additional input longer than seedlen accepted\n");
+            break;
+        }
+        
+        printf("    OK\n");
+        ok = true;
+    }
+    
+    aes256_set_backend(AES_BACKEND_AUTO);
+    
+    if (!ok) {
+        return false;
+    }
+    
+    // generate_bytes с заданной энтропией совпадает с DRBG, без неё - случаен
+    Aes256CtrDrbg drbg;
+    aes256_ctr_drbg_init(&drbg, entropy, nullptr, 0);
+    aes256_ctr_drbg_generate(&drbg, pieces.data(), n, nullptr, 0);
+    if (generate_bytes(n, entropy, whole.data()) != STATUS_OK || whole != pieces) {
+        printf("  ERROR: generate_bytes differs from aes256_ctr_drbg_generate\n");
+        return false;
+    }
+    if (generate_bytes(n, nullptr, whole.data()) != STATUS_OK || generate_bytes(n, nullptr, pieces.data()) != STATUS_OK ||
+        whole == pieces) {
+        printf("  ERROR: generate_bytes without seed failed or repeated its output\n");
+        return false;
+    }
+    
+    printf("test_aes256_ctr_drbg: OK\n");
+    return true;
+}
+
+bool test_chacha20_poly1305() {
+    printf("Running ChaCha20-Poly1305 tests...\n");
+    
+    const size_t n = 1024 * 1024 + 13;
+    std::mt19937 gen(17);
+    std::vector<uint8_t> plaintext(n), reference(n), ciphertext(n), decrypted(n), aad(37);
+    for (size_t i = 0; i < n; i++) {
+        plaintext[i] = (uint8_t)gen();
+    }
+    for (size_t i = 0; i < aad.size(); i++) {
+        aad[i] = (uint8_t)gen();
+    }
+    uint8_t key[32], nonce[12], reference_tag[16];
+    for (int i = 0; i < 32; i++) {
+        key[i] = (uint8_t)gen();
+    }
+    for (int i = 0; i < 12; i++) {
+        nonce[i] = (uint8_t)gen();
+    }
+    
+    const ChachaBackend backends[] = {CHACHA_BACKEND_PORTABLE, CHACHA_BACKEND_AVX2};
+    const char* names[] = {"portable", "avx2"};
+    bool ok = true;
+    
+    for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]) && ok; ++b) {
+        if (chacha20_poly1305_set_backend(backends[b]) != STATUS_OK) {
+            printf("  %s: not supported on this CPU, skipped\n", names[b]);
+            continue;
+        }
+        printf("  %s\n", names[b]);
+        
+        for (size_t i = 0; i < NUM_OF_TESTCASES_CHACHA && ok; ++i) {
+            const TestCaseAESAAD& tc = testcases_chacha[i];
+            printf("    Test %zu: data size = %zu bytes, AAD size = %zu bytes\n", i + 1, tc.n, tc.aad.size());
+            ok = false;
+            
+            std::vector<uint8_t> answer(tc.n);
+            uint8_t tag[16];
+            Status status = chacha20_poly1305_encrypt_aad(tc.plaintext.data(), answer.data(), tc.key.data(), tc.iv.data(),
+                                                          tc.n, tc.aad.data(), tc.aad.size(), tag);
+            if (status != STATUS_OK || memcmp(answer.data(), tc.ciphertext.data(), tc.n) != 0 ||
+                memcmp(tag, tc.tag.data(), 16) != 0) {
+                printf("      ERROR: ciphertext or tag mismatch, status %d\n", status);
+                break;
+            }
+            
+            // Расшифрование на месте
+            status = chacha20_poly1305_decrypt(answer.data(), answer.data(), tc.key.data(), tc.iv.data(), tc.n,
+                                               tc.aad.data(), tc.aad.size(), tc.tag.data());
+            if (status != STATUS_OK || memcmp(answer.data(), tc.plaintext.data(), tc.n) != 0) {
+                printf("      ERROR: decryption failed, status %d\n", status);
+                break;
+            }
+            
+            uint8_t bad_tag[16];
+            memcpy(bad_tag, tc.tag.data(), 16);
+            bad_tag[15] ^= 0x80;
+            std::vector<uint8_t> rejected(tc.n, 0xAA);
+            status = chacha20_poly1305_decrypt(tc.ciphertext.data(), rejected.data(), tc.key.data(), tc.iv.data(), tc.n,
+                                               tc.aad.data(), tc.aad.size(), bad_tag);
+            if (status == STATUS_OK || std::count(rejected.begin(), rejected.end(), 0) != (long)tc.n) {
+                printf("      ERROR: forged tag accepted or plaintext not wiped\n");
+                break;
+            }
+            
+            printf("      OK\n");
+            ok = true;
+        }
+        if (!ok) {
+            break;
+        }
+        ok = false;
+        
+        // Длинное сообщение идёт по потокам и должно совпадать между реализациями
+        uint8_t tag[16];
+        std::vector<uint8_t>& target = (b == 0) ? reference : ciphertext;
+        chacha20_poly1305_encrypt_aad(plaintext.data(), target.data(), key, nonce, n, aad.data(), aad.size(),
+                                      b == 0 ? reference_tag : tag);
+        if (b != 0 && (ciphertext != reference || memcmp(tag, reference_tag, 16) != 0)) {
+            printf("    ERROR: %zu-byte message differs from portable backend\n", n);
+            break;
+        }
+        if (chacha20_poly1305_decrypt(target.data(), decrypted.data(), key, nonce, n, aad.data(), aad.size(),
+                                      reference_tag) != STATUS_OK || decrypted != plaintext) {
+            printf("    ERROR: %zu-byte round trip failed\n", n);
+            break;
+        }
+        
+        if (chacha20_poly1305(plaintext.data(), plaintext.data() + 1, key, nonce, 4096, tag) == STATUS_OK) {
+            printf("    ERROR: partially overlapping buffers accepted\n");
+            break;
+        }
+        
+        printf("    OK (%zu bytes)\n", n);
+        ok = true;
+    }
+    
+    chacha20_poly1305_set_backend(CHACHA_BACKEND_AUTO);
+    
+    if (!ok) {
+        return false;
+    }
+    
+    printf("test_chacha20_poly1305: OK\n");
+    return true;
+}
+
+// Побитовый эталон CRC с отражённым полиномом poly для сверки ядер на произвольных длинах
+static uint32_t crc_reference(uint32_t poly, const uint8_t* data, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= data[i];
+        for (int k = 0; k < 8; ++k) {
+            crc = (crc >> 1) ^ (poly & (0u - (crc & 1)));
+        }
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+bool test_crc32() {
+    printf("Running CRC32 tests...\n");
+    
+    const Crc32Backend backends[] = {CRC32_BACKEND_SLICING16, CRC32_BACKEND_CLMUL};
+    const char* names[] = {"slicing16", "clmul"};
+    
+    // Длины вокруг границ свёртки (16/64 байта) и невыровненные смещения,
+    // плюс 9 МБ буфер против побитового эталона
+    std::mt19937 gen(20);
+    std::vector<uint8_t> buffer(9 * 1024 * 1024 + 77);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = (uint8_t)gen();
+    }
+    const uint32_t big_expected = crc_reference(0xEDB88320, buffer.data(), buffer.size());
+    
+    for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); ++b) {
+        if (crc32_set_backend(backends[b]) != STATUS_OK) {
+            printf("  %s: not supported on this CPU, skipped\n", names[b]);
+            continue;
+        }
+        printf("  %s\n", names[b]);
+        
+        for (size_t i = 0; i < NUM_OF_TESTCASES_CRC32; ++i) {
+            printf("    Test %zu: \"%s\" (%zu bytes)\n", i + 1, 
+                   testcases_crc32[i].input.empty() ? "(empty string)" : testcases_crc32[i].input.c_str(),
+                   testcases_crc32[i].input.size());
+            
+            uint32_t result;
+            Status status = crc32((const uint8_t*)(testcases_crc32[i].input.data()), 
+                                 testcases_crc32[i].input.size(), &result);
+            
+            if (status != STATUS_OK) {
+                printf("      ERROR: crc32 function returned status %d\n", status);
+                crc32_set_backend(CRC32_BACKEND_AUTO);
+                return false;
+            }
+            
+            if (result != testcases_crc32[i].result) {
+                printf("      ERROR: CRC32 mismatch\n");
+                printf("      Expected: 0x%08X, Got: 0x%08X\n", 
+                       testcases_crc32[i].result, result);
+                crc32_set_backend(CRC32_BACKEND_AUTO);
+                return false;
+            }
+            
+            printf("      OK (CRC32: 0x%08X)\n", result);
+        }
+        
+        for (size_t len = 0; len <= 1100; ++len) {
+            size_t offset = len % 16;
+            uint32_t result = 0;
+            crc32(buffer.data() + offset, len, &result);
+            uint32_t expected = crc_reference(0xEDB88320, buffer.data() + offset, len);
+            if (result != expected) {
+                printf("      ERROR: CRC32 mismatch at length %zu, offset %zu\n", len, offset);
+                printf("      Expected: 0x%08X, Got: 0x%08X\n", expected, result);
+                crc32_set_backend(CRC32_BACKEND_AUTO);
+                return false;
+            }
+        }
+        printf("    Lengths 0..1100: OK\n");
+        
+        uint32_t result = 0;
+        crc32(buffer.data(), buffer.size(), &result);
+        if (result != big_expected) {
+            printf("      ERROR: CRC32 mismatch on %zu bytes\n", buffer.size());
+            printf("      Expected: 0x%08X, Got: 0x%08X\n", big_expected, result);
+            crc32_set_backend(CRC32_BACKEND_AUTO);
+            return false;
+        }
+        printf("    %zu bytes: OK (CRC32: 0x%08X)\n", buffer.size(), result);
+    }
+    
+    crc32_set_backend(CRC32_BACKEND_AUTO);
     printf("test_crc32: OK\n");
     return true;
 }
 
 
+bool test_crc32c() {
+    printf("Running CRC32C tests...\n");
+    
+    const Crc32cBackend backends[] = {CRC32C_BACKEND_SLICING16, CRC32C_BACKEND_SSE42};
+    const char* names[] = {"slicing16", "sse42"};
+    
+    // Длины вокруг отрезков трёхпоточного ядра (3 x 256 и 3 x 8192 байт)
+    // и невыровненные смещения, плюс 9 МБ буфер против побитового эталона
+    std::mt19937 gen(21);
+    std::vector<uint8_t> buffer(9 * 1024 * 1024 + 77);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = (uint8_t)gen();
+    }
+    const uint32_t big_expected = crc_reference(0x82F63B78, buffer.data(), buffer.size());
+    std::vector<size_t> lengths;
+    for (size_t len = 0; len <= 1100; ++len) {
+        lengths.push_back(len);
+    }
+    for (size_t len = 3 * 8192 - 20; len <= 3 * 8192 + 820; len += 7) {
+        lengths.push_back(len);
+    }
+    
+    for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); ++b) {
+        if (crc32c_set_backend(backends[b]) != STATUS_OK) {
+            printf("  %s: not supported on this CPU, skipped\n", names[b]);
+            continue;
+        }
+        printf("  %s\n", names[b]);
+        
+        for (size_t i = 0; i < NUM_OF_TESTCASES_CRC32C; ++i) {
+            printf("    Test %zu: %zu bytes\n", i + 1, testcases_crc32c[i].input.size());
+            
+            uint32_t result;
+            Status status = crc32c((const uint8_t*)(testcases_crc32c[i].input.data()),
+                                   testcases_crc32c[i].input.size(), &result);
+            
+            if (status != STATUS_OK) {
+                printf("      ERROR: crc32c function returned status %d\n", status);
+                crc32c_set_backend(CRC32C_BACKEND_AUTO);
+                return false;
+            }
+            
+            if (result != testcases_crc32c[i].result) {
+                printf("      ERROR: CRC32C mismatch\n");
+                printf("      Expected: 0x%08X, Got: 0x%08X\n", testcases_crc32c[i].result, result);
+                crc32c_set_backend(CRC32C_BACKEND_AUTO);
+                return false;
+            }
+            
+            printf("      OK (CRC32C: 0x%08X)\n", result);
+        }
+        
+        for (size_t i = 0; i < lengths.size(); ++i) {
+            size_t len = lengths[i];
+            size_t offset = len % 16;
+            uint32_t result = 0;
+            crc32c(buffer.data() + offset, len, &result);
+            uint32_t expected = crc_reference(0x82F63B78, buffer.data() + offset, len);
+            if (result != expected) {
+                printf("      ERROR: CRC32C mismatch at length %zu, offset %zu\n", len, offset);
+                printf("      Expected: 0x%08X, Got: 0x%08X\n", expected, result);
+                crc32c_set_backend(CRC32C_BACKEND_AUTO);
+                return false;
+            }
+        }
+        printf("    %zu lengths up to %zu bytes: OK\n", lengths.size(), lengths.back());
+        
+        uint32_t result = 0;
+        crc32c(buffer.data(), buffer.size(), &result);
+        if (result != big_expected) {
+            printf("      ERROR: CRC32C mismatch on %zu bytes\n", buffer.size());
+            printf("      Expected: 0x%08X, Got: 0x%08X\n", big_expected, result);
+            crc32c_set_backend(CRC32C_BACKEND_AUTO);
+            return false;
+        }
+        printf("    %zu bytes: OK (CRC32C: 0x%08X)\n", buffer.size(), result);
+    }
+    
+    crc32c_set_backend(CRC32C_BACKEND_AUTO);
+    printf("test_crc32c: OK\n");
+    return true;
+}
+
+
+// Поток режется на куски от пустых до нескольких мегабайт;
+// результат должен совпасть с однократным вызовом на всём буфере
+bool test_crc32_update() {
+    printf("Running CRC32 streaming tests...\n");
+    
+    std::mt19937 gen(22);
+    std::vector<uint8_t> buffer(9 * 1024 * 1024 + 77);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = (uint8_t)gen();
+    }
+    
+    typedef Status (*OneshotFn)(const uint8_t*, size_t, uint32_t*);
+    typedef Status (*UpdateFn)(uint32_t, const uint8_t*, size_t, uint32_t*);
+    const OneshotFn oneshot[] = {crc32, crc32c};
+    const UpdateFn update[] = {crc32_update, crc32c_update};
+    const char* names[] = {"crc32", "crc32c"};
+    
+    for (size_t f = 0; f < 2; ++f) {
+        printf("  %s\n", names[f]);
+        
+        // Пустой кусок оставляет значение как есть
+        uint32_t result = 0;
+        if (update[f](0x12345678, nullptr, 0, &result) != STATUS_OK || result != 0x12345678) {
+            printf("    ERROR: empty update changed the CRC\n");
+            return false;
+        }
+        
+        // Побайтово, по 1..300 байт и кусками до 8 МБ
+        const size_t max_piece[] = {1, 300, 70000, 8 * 1024 * 1024 + 4096};
+        for (size_t m = 0; m < sizeof(max_piece) / sizeof(max_piece[0]); ++m) {
+            size_t len = (max_piece[m] == 1) ? 4099 : buffer.size();
+            uint32_t expected = 0;
+            oneshot[f](buffer.data(), len, &expected);
+            
+            uint32_t crc = 0;
+            size_t pieces = 0;
+            for (size_t pos = 0; pos < len; ++pieces) {
+                size_t n = std::min<size_t>(gen() % (max_piece[m] + 1), len - pos);
+                if (update[f](crc, buffer.data() + pos, n, &crc) != STATUS_OK) {
+                    printf("    ERROR: update returned an error\n");
+                    return false;
+                }
+                pos += n;
+            }
+            
+            if (crc != expected) {
+                printf("    ERROR: %zu pieces of up to %zu bytes\n", pieces, max_piece[m]);
+                printf("    Expected: 0x%08X, Got: 0x%08X\n", expected, crc);
+                return false;
+            }
+            printf("    %zu pieces of up to %zu bytes: OK (0x%08X)\n", pieces, max_piece[m], crc);
+        }
+        
+        // Продолжение уже посчитанного CRC большим куском
+        uint32_t head = 0, expected = 0;
+        oneshot[f](buffer.data(), buffer.size(), &expected);
+        update[f](0, buffer.data(), 1000, &head);
+        update[f](head, buffer.data() + 1000, buffer.size() - 1000, &result);
+        if (result != expected) {
+            printf("    ERROR: 1000 bytes + %zu bytes\n", buffer.size() - 1000);
+            printf("    Expected: 0x%08X, Got: 0x%08X\n", expected, result);
+            return false;
+        }
+        printf("    1000 + %zu bytes: OK\n", buffer.size() - 1000);
+    }
+    
+    printf("test_crc32_update: OK\n");
+    return true;
+}
+
+// Нечётное число потоков: буфер делится на 3 и 5 кусков, последний короче,
+// и дерево слияния содержит непарные узлы. Число потоков задаётся явно,
+// чтобы деление проверялось и на машине с одним ядром
+bool test_crc32_threads() {
+    printf("Running CRC32/CRC32C tests with odd thread counts...\n");
+    
+    std::mt19937 gen(24);
+    std::vector<uint8_t> buffer(1024 * 1024 + 4099);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = (uint8_t)gen();
+    }
+    const uint32_t expected[2] = {crc_reference(0xEDB88320, buffer.data(), buffer.size()),
+                                  crc_reference(0x82F63B78, buffer.data(), buffer.size())};
+    
+    typedef Status (*OneshotFn)(const uint8_t*, size_t, uint32_t*);
+    typedef Status (*UpdateFn)(uint32_t, const uint8_t*, size_t, uint32_t*);
+    const OneshotFn oneshot[] = {crc32, crc32c};
+    const UpdateFn update[] = {crc32_update, crc32c_update};
+    const char* names[] = {"crc32", "crc32c"};
+    const int thread_counts[] = {3, 5};
+    const int saved_threads = omp_get_max_threads();
+    
+    bool ok = true;
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]) && ok; ++t) {
+        omp_set_num_threads(thread_counts[t]);
+        for (size_t f = 0; f < 2 && ok; ++f) {
+            uint32_t result = 0, head = 0, continued = 0;
+            oneshot[f](buffer.data(), buffer.size(), &result);
+            update[f](0, buffer.data(), 777, &head);
+            update[f](head, buffer.data() + 777, buffer.size() - 777, &continued);
+            
+            if (result != expected[f] || continued != expected[f]) {
+                printf("  ERROR: %s with %d threads\n", names[f], thread_counts[t]);
+                printf("  Expected: 0x%08X, Got: 0x%08X (one-shot), 0x%08X (update)\n",
+                       expected[f], result, continued);
+                ok = false;
+            }
+        }
+        if (ok) {
+            printf("  %d threads: OK\n", thread_counts[t]);
+        }
+    }
+    
+    omp_set_num_threads(saved_threads);
+    if (!ok) {
+        return false;
+    }
+    
+    printf("test_crc32_threads: OK\n");
+    return true;
+}
+
+
+bool test_crc32_combine() {
+    printf("Running CRC32 combine tests...\n");
+    
+    std::mt19937_64 gen(23);
+    std::vector<uint8_t> buffer(1 << 20);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = (uint8_t)gen();
+    }
+    
+    typedef Status (*OneshotFn)(const uint8_t*, size_t, uint32_t*);
+    typedef uint32_t (*CombineFn)(uint32_t, uint32_t, size_t);
+    const OneshotFn oneshot[] = {crc32, crc32c};
+    const CombineFn combine[] = {crc32_combine, crc32c_combine};
+    const char* names[] = {"crc32", "crc32c"};
+    
+    for (size_t f = 0; f < 2; ++f) {
+        printf("  %s\n", names[f]);
+        
+        // CRC(A || B) из CRC(A), CRC(B) и len(B), включая пустые части
+        for (int i = 0; i < 1000; ++i) {
+            size_t len = (i < 100) ? (size_t)i : (size_t)(gen() % (buffer.size() + 1));
+            size_t split = (size_t)(gen() % (len + 1));
+            uint32_t whole = 0, first = 0, second = 0;
+            oneshot[f](buffer.data(), len, &whole);
+            oneshot[f](buffer.data(), split, &first);
+            oneshot[f](buffer.data() + split, len - split, &second);
+            
+            uint32_t result = combine[f](first, second, len - split);
+            if (result != whole) {
+                printf("    ERROR: %zu + %zu bytes\n", split, len - split);
+                printf("    Expected: 0x%08X, Got: 0x%08X\n", whole, result);
+                return false;
+            }
+        }
+        printf("    1000 random splits: OK\n");
+        
+        // Длины, которые не посчитать напрямую: склейка должна быть ассоциативной
+        for (int i = 0; i < 1000; ++i) {
+            uint32_t a = (uint32_t)gen(), b = (uint32_t)gen(), c = (uint32_t)gen();
+            size_t n = (size_t)(gen() >> (gen() % 64)) >> 1;
+            size_t m = (size_t)(gen() >> (gen() % 64)) >> 1;
+            uint32_t left = combine[f](combine[f](a, b, n), c, m);
+            uint32_t right = combine[f](a, combine[f](b, c, m), n + m);
+            if (left != right) {
+                printf("    ERROR: combine is not associative for lengths %zu and %zu\n", n, m);
+                return false;
+            }
+        }
+        printf("    1000 associativity checks up to 2^63 bytes: OK\n");
+    }
+    
+    printf("test_crc32_combine: OK\n");
+    return true;
+}
+
+
 int run_correctness() {
     bool all_tests_passed = true;
 
@@ -504,7 +2049,24 @@ int run_correctness() {
     all_tests_passed &= test_exponential();
     all_tests_passed &= test_bernoulli();
     all_tests_passed &= test_aes256_gcm();
+    all_tests_passed &= test_aes256_gcm_context();
+    all_tests_passed &= test_aes256_gcm_backends();
+    all_tests_passed &= test_aes256_gcm_stream();
+    all_tests_passed &= test_aes256_gcm_aad();
+    all_tests_passed &= test_aes256_gcm_decrypt();
+    all_tests_passed &= test_aes256_gcm_threads();
+    all_tests_passed &= test_aes256_gcm_inplace();
+    all_tests_passed &= test_aes256_gcm_batch();
+    all_tests_passed &= test_aes256_gcm_iov();
+    all_tests_passed &= test_aes256_gcm_chunked();
+    all_tests_passed &= test_aes256_ecb();
+    all_tests_passed &= test_aes256_ctr_drbg();
+    all_tests_passed &= test_chacha20_poly1305();
     all_tests_passed &= test_crc32();
+    all_tests_passed &= test_crc32c();
+    all_tests_passed &= test_crc32_update();
+    all_tests_passed &= test_crc32_threads();
+    all_tests_passed &= test_crc32_combine();
     
     if (!all_tests_passed) {
         printf("Correctness tests failed\n");
@@ -0,0 +1,240 @@
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "tests.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Статистический тест постоянного времени в духе dudect (Reparaz, Balasch, Verbauwhede):
+// замеры на фиксированном и на случайных секретных входах в случайном порядке,
+// затем t-критерий Уэлча по всем замерам и по отсечённым сверху по перцентилям.
+// |t| > 10 - утечка почти наверняка, > 4.5 - подозрение.
+
+#define CT_MEASUREMENTS 200000
+#define CT_WARMUP 1000
+#define CT_PERCENTILES 100
+#define CT_MIN_PER_CLASS 1000
+#define CT_T_LEAK 10.0
+#define CT_T_SUSPECT 4.5
+
+struct CtResult {
+    const char* function_name;
+    int measurements;
+    double max_t;
+    bool constant_time; // реализация заявлена как константная по времени
+};
+
+void print_ct_table(CtResult* results, int count) {
+    printf("┌─────────────────────┬────────────┬──────────────┬──────────────┐\n");
+    printf("│ Function            │ Samples    │ max |t|      │ Verdict      │\n");
+    printf("├─────────────────────┼────────────┼──────────────┼──────────────┤\n");
+
+    for (int i = 0; i < count; i++) {
+        const char* verdict = "skipped";
+        if (results[i].measurements > 0) {
+            verdict = (results[i].max_t > CT_T_LEAK) ? "leaks" : (results[i].max_t > CT_T_SUSPECT) ? "suspect" : "ok";
+        }
+        printf("│ %-19s │ %10d │ %12.2f │ %-12s │\n",
+               results[i].function_name,
+               results[i].measurements,
+               results[i].max_t,
+               verdict);
+    }
+
+    printf("└─────────────────────┴────────────┴──────────────┴──────────────┘\n");
+}
+
+// Счётчик тактов с барьерами, чтобы замер не перекрывался с соседним кодом
+static inline uint64_t ct_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_lfence();
+    uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Онлайн-оценка среднего и дисперсии (Уэлфорд) для двух классов
+struct WelchTest {
+    double n[2];
+    double mean[2];
+    double m2[2];
+
+    WelchTest() {
+        for (int c = 0; c < 2; c++) {
+            n[c] = mean[c] = m2[c] = 0.0;
+        }
+    }
+
+    void push(double x, int c) {
+        n[c] += 1.0;
+        double delta = x - mean[c];
+        mean[c] += delta / n[c];
+        m2[c] += delta * (x - mean[c]);
+    }
+
+    bool enough() const {
+        return n[0] >= CT_MIN_PER_CLASS && n[1] >= CT_MIN_PER_CLASS;
+    }
+
+    double t() const {
+        double var0 = m2[0] / (n[0] - 1.0);
+        double var1 = m2[1] / (n[1] - 1.0);
+        double den = std::sqrt(var0 / n[0] + var1 / n[1]);
+        return (den > 0.0) ? (mean[0] - mean[1]) / den : 0.0;
+    }
+};
+
+// Операция над секретным входом фиксированной длины
+typedef void (*CtOperation)(const void* state, const uint8_t* input, uint8_t* output);
+
+static CtResult run_dudect(const char* name, bool constant_time, CtOperation op, const void* state,
+                           size_t input_len, size_t output_len) {
+    std::mt19937 gen(2025);
+    std::vector<uint8_t> inputs(CT_MEASUREMENTS * input_len);
+    std::vector<int> classes(CT_MEASUREMENTS);
+    std::vector<uint8_t> output(output_len);
+    std::vector<uint64_t> cycles(CT_MEASUREMENTS);
+
+    // Класс 0 - нулевой вход, класс 1 - случайный
+    for (size_t i = 0; i < CT_MEASUREMENTS; i++) {
+        classes[i] = (int)(gen() & 1);
+        uint8_t* in = &inputs[i * input_len];
+        for (size_t j = 0; j < input_len; j++) {
+            in[j] = classes[i] ? (uint8_t)gen() : 0;
+        }
+    }
+
+    for (size_t i = 0; i < CT_WARMUP; i++) {
+        op(state, &inputs[(i % CT_MEASUREMENTS) * input_len], output.data());
+    }
+    for (size_t i = 0; i < CT_MEASUREMENTS; i++) {
+        uint64_t start = ct_cycles();
+        op(state, &inputs[i * input_len], output.data());
+        cycles[i] = ct_cycles() - start;
+    }
+
+    // Отсечки по перцентилям убирают хвост из прерываний и промахов кэша,
+    // которые не зависят от класса, но маскируют разницу средних
+    std::vector<uint64_t> sorted(cycles);
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<uint64_t> thresholds(CT_PERCENTILES);
+    for (size_t k = 0; k < CT_PERCENTILES; k++) {
+        double p = 1.0 - std::pow(0.5, 10.0 * (double)(k + 1) / CT_PERCENTILES);
+        thresholds[k] = sorted[(size_t)(p * (CT_MEASUREMENTS - 1))];
+    }
+
+    std::vector<WelchTest> tests(CT_PERCENTILES + 1);
+    for (size_t i = 0; i < CT_MEASUREMENTS; i++) {
+        double x = (double)cycles[i];
+        tests[0].push(x, classes[i]);
+        for (size_t k = 0; k < CT_PERCENTILES; k++) {
+            if (cycles[i] < thresholds[k]) {
+                tests[k + 1].push(x, classes[i]);
+            }
+        }
+    }
+
+    double max_t = 0.0;
+    for (size_t k = 0; k < tests.size(); k++) {
+        if (tests[k].enough()) {
+            max_t = std::max(max_t, std::fabs(tests[k].t()));
+        }
+    }
+
+    printf("  %-19s max |t| = %.2f, median %llu cycles\n", name, max_t,
+           (unsigned long long)sorted[CT_MEASUREMENTS / 2]);
+    return {name, CT_MEASUREMENTS, max_t, constant_time};
+}
+
+// AES: секрет - открытый текст при фиксированном ключе (индексы таблиц = pt ^ k)
+static void ct_aes_ecb(const void* state, const uint8_t* input, uint8_t* output) {
+    aes256_ecb_encrypt((const Aes256EcbContext*)state, input, output, 128);
+}
+
+// GHASH: секрет - AAD, которая проходит через умножение на H; AES-часть одинакова для классов
+static void ct_ghash(const void* state, const uint8_t* input, uint8_t* output) {
+    static const uint8_t iv[12] = {0};
+    aes256_gcm_encrypt_aad((const Aes256GcmContext*)state, nullptr, nullptr, iv, 0, input, 256, output);
+}
+
+static CtResult ct_aes_backend(AesBackend backend, const char* name, bool constant_time) {
+    if (aes256_set_backend(backend) != STATUS_OK) {
+        printf("  %-19s not supported on this CPU, skipped\n", name);
+        return {name, 0, 0.0, constant_time};
+    }
+
+    uint8_t key[32];
+    for (int i = 0; i < 32; i++) {
+        key[i] = (uint8_t)(i * 7 + 1);
+    }
+    Aes256EcbContext ctx;
+    aes256_ecb_init(&ctx, key);
+
+    CtResult r = run_dudect(name, constant_time, ct_aes_ecb, &ctx, 128, 128);
+    aes256_set_backend(AES_BACKEND_AUTO);
+    return r;
+}
+
+static CtResult ct_ghash_backend(GhashBackend backend, const char* name, bool constant_time) {
+    if (aes256_gcm_set_ghash_backend(backend) != STATUS_OK) {
+        printf("  %-19s not supported on this CPU, skipped\n", name);
+        return {name, 0, 0.0, constant_time};
+    }
+
+    uint8_t key[32];
+    for (int i = 0; i < 32; i++) {
+        key[i] = (uint8_t)(i * 5 + 3);
+    }
+    Aes256GcmContext ctx;
+    aes256_gcm_init(&ctx, key);
+
+    CtResult r = run_dudect(name, constant_time, ct_ghash, &ctx, 256, 16);
+    aes256_gcm_set_ghash_backend(GHASH_BACKEND_AUTO);
+    return r;
+}
+
+int run_constant_time() {
+    printf("Running constant-time tests (%d measurements per backend)...\n", CT_MEASUREMENTS);
+
+    CtResult results[10];
+    results[0] = ct_aes_backend(AES_BACKEND_BYTEWISE, "aes bytewise", false);
+    results[1] = ct_aes_backend(AES_BACKEND_TTABLE, "aes ttable", false);
+    results[2] = ct_aes_backend(AES_BACKEND_BITSLICED, "aes bitsliced", true);
+    results[3] = ct_aes_backend(AES_BACKEND_AESNI, "aes aesni", true);
+    results[4] = ct_aes_backend(AES_BACKEND_VAES, "aes vaes", true);
+    results[5] = ct_ghash_backend(GHASH_BACKEND_BITWISE, "ghash bitwise", false);
+    results[6] = ct_ghash_backend(GHASH_BACKEND_SHOUP4, "ghash shoup4", false);
+    results[7] = ct_ghash_backend(GHASH_BACKEND_SHOUP8, "ghash shoup8", false);
+    results[8] = ct_ghash_backend(GHASH_BACKEND_CLMUL, "ghash clmul", true);
+    results[9] = ct_ghash_backend(GHASH_BACKEND_VPCLMUL, "ghash vpclmul", true);
+
+    print_ct_table(results, 10);
+
+    // Утечка в табличных реализациях ожидаема; регрессия - только у заявленных константными
+    bool regression = false;
+    for (int i = 0; i < 10; i++) {
+        if (results[i].constant_time && results[i].measurements > 0 && results[i].max_t > CT_T_LEAK) {
+            printf("ERROR: %s shows data-dependent timing\n", results[i].function_name);
+            regression = true;
+        }
+    }
+
+    if (regression) {
+        printf("Constant-time tests failed\n");
+        return 1;
+    }
+
+    printf("Constant-time tests passed\n");
+    return 0;
+}
@@ -1,8 +1,11 @@
 #include <cstdio>
 #include <cstdint>
 #include <chrono>
+#include <algorithm>
+#include <random>
 #include <string>
 #include <iostream>
+#include <omp.h>
 #include "tests.hpp"
 
 struct BenchmarkResult {
@@ -26,6 +29,53 @@ void print_performance_table(BenchmarkResult* results, int count) {
     printf("└─────────────────────┴────────────┴──────────────┘\n");
 }
 
+struct LatencyResult {
+    const char* function_name;
+    int calls;
+    double p50_ns;
+    double p99_ns;
+};
+
+void print_latency_table(LatencyResult* results, int count) {
+    printf("┌─────────────────────┬────────────┬──────────────┬──────────────┐\n");
+    printf("│ Function            │ Calls      │ p50 (ns)     │ p99 (ns)     │\n");
+    printf("├─────────────────────┼────────────┼──────────────┼──────────────┤\n");
+    
+    for (int i = 0; i < count; i++) {
+        printf("│ %-19s │ %10d │ %12.0f │ %12.0f │\n",
+               results[i].function_name,
+               results[i].calls,
+               results[i].p50_ns,
+               results[i].p99_ns);
+    }
+    
+    printf("└─────────────────────┴────────────┴──────────────┴──────────────┘\n");
+}
+
+struct ScalingResult {
+    const char* size_name;
+    size_t bytes;
+    double single_gbps;
+    double multi_gbps;
+};
+
+void print_scaling_table(const char* title, ScalingResult* results, int count, int threads) {
+    printf("%s: throughput on 1 and %d threads\n", title, threads);
+    printf("┌────────────┬──────────────┬──────────────┬──────────┐\n");
+    printf("│ Size       │ 1 thr (GB/s) │ N thr (GB/s) │ Speedup  │\n");
+    printf("├────────────┼──────────────┼──────────────┼──────────┤\n");
+    
+    for (int i = 0; i < count; i++) {
+        printf("│ %-10s │ %12.2f │ %12.2f │ %8.2f │\n",
+               results[i].size_name,
+               results[i].single_gbps,
+               results[i].multi_gbps,
+               results[i].multi_gbps / results[i].single_gbps);
+    }
+    
+    printf("└────────────┴──────────────┴──────────────┴──────────┘\n");
+}
+
 template<typename Func, typename... Args>
 double measure_time(Func func, const std::string& func_name, Args&&... args) {
     std::chrono::high_resolution_clock::time_point start_time, end_time;
@@ -102,6 +152,17 @@ BenchmarkResult benchmark_bernoulli() {
     return {"bernoulli", N, best_time};
 }
 
+BenchmarkResult benchmark_bytes() {
+    int N = 1000000000;
+    std::vector<uint8_t> result(N);
+    std::vector<uint8_t> seed(48, 42);
+
+    Status (* volatile generate_bytes_ptr)(size_t, const uint8_t*, uint8_t*) = &generate_bytes;
+    double best_time = measure_time(generate_bytes_ptr, "bytes", N, seed.data(), result.data());
+
+    return {"bytes drbg", N, best_time};
+}
+
 BenchmarkResult benchmark_aes256_gcm() {
     int N = 2097152;
     std::vector<uint8_t> plaintext(N, 7);
@@ -116,6 +177,327 @@ BenchmarkResult benchmark_aes256_gcm() {
     return {"aes256_gcm", N, best_time};
 }
 
+// Та же нагрузка, что и benchmark_aes256_gcm: второй AEAD на том же размере
+BenchmarkResult benchmark_chacha20_poly1305() {
+    int N = 2097152;
+    std::vector<uint8_t> plaintext(N, 7);
+    std::vector<uint8_t> ciphertext(N, 0);
+    std::vector<uint8_t> key(32, 1);
+    std::vector<uint8_t> nonce(12, 2);
+    uint8_t tag[16];
+
+    Status (* volatile chacha20_poly1305_ptr)(const uint8_t*, uint8_t*, const uint8_t*, const uint8_t*, size_t, uint8_t*) = &chacha20_poly1305;
+    double best_time = measure_time(chacha20_poly1305_ptr, "chacha20_poly1305", plaintext.data(), ciphertext.data(), key.data(), nonce.data(), N, tag);
+
+    return {"chacha20_poly1305", N, best_time};
+}
+
+// Та же нагрузка, что и benchmark_aes256_gcm, но с принудительно выбранной реализацией AES
+BenchmarkResult benchmark_aes256_gcm_backend(AesBackend backend, const char* name) {
+    if (aes256_set_backend(backend) != STATUS_OK) {
+        return {name, 0, 0.0};
+    }
+    BenchmarkResult result = benchmark_aes256_gcm();
+    result.function_name = name;
+    aes256_set_backend(AES_BACKEND_AUTO);
+    return result;
+}
+
+BenchmarkResult benchmark_aes256_gcm_ghash(GhashBackend backend, const char* name) {
+    if (aes256_gcm_set_ghash_backend(backend) != STATUS_OK) {
+        return {name, 0, 0.0};
+    }
+    BenchmarkResult result = benchmark_aes256_gcm();
+    result.function_name = name;
+    aes256_gcm_set_ghash_backend(GHASH_BACKEND_AUTO);
+    return result;
+}
+
+// Те же 2 МБ, поданные в поток кусками по 64 КБ
+static Status aes256_gcm_stream_chunks(const uint8_t* plaintext, uint8_t* ciphertext,
+                                       const uint8_t* key, const uint8_t* iv, size_t len, uint8_t* tag) {
+    const size_t chunk = 64 * 1024;
+    
+    Aes256GcmContext ctx;
+    Aes256GcmStream stream;
+    aes256_gcm_init(&ctx, key);
+    aes256_gcm_stream_init(&stream, &ctx, iv);
+    for (size_t pos = 0; pos < len; pos += chunk) {
+        size_t n = (pos + chunk <= len) ? chunk : len - pos;
+        aes256_gcm_stream_update(&stream, plaintext + pos, ciphertext + pos, n);
+    }
+    return aes256_gcm_stream_final(&stream, tag);
+}
+
+BenchmarkResult benchmark_aes256_gcm_stream() {
+    int N = 2097152;
+    std::vector<uint8_t> plaintext(N, 7);
+    std::vector<uint8_t> ciphertext(N, 0);
+    std::vector<uint8_t> key(32, 1);
+    std::vector<uint8_t> iv(12, 2);
+    uint8_t tag[16];
+
+    Status (* volatile stream_ptr)(const uint8_t*, uint8_t*, const uint8_t*, const uint8_t*, size_t, uint8_t*) = &aes256_gcm_stream_chunks;
+    double best_time = measure_time(stream_ptr, "aes_gcm stream", plaintext.data(), ciphertext.data(), key.data(), iv.data(), N, tag);
+
+    return {"aes_gcm stream", N, best_time};
+}
+
+// Те же 2 МБ, зашифрованные на месте: один буфер вместо двух
+static Status aes256_gcm_inplace_oneshot(uint8_t* data, const uint8_t* key, const uint8_t* iv, size_t len, uint8_t* tag) {
+    Aes256GcmContext ctx;
+    aes256_gcm_init(&ctx, key);
+    return aes256_gcm_encrypt_inplace(&ctx, data, iv, len, nullptr, 0, tag);
+}
+
+BenchmarkResult benchmark_aes256_gcm_inplace() {
+    int N = 2097152;
+    std::vector<uint8_t> data(N, 7);
+    std::vector<uint8_t> key(32, 1);
+    std::vector<uint8_t> iv(12, 2);
+    uint8_t tag[16];
+
+    Status (* volatile inplace_ptr)(uint8_t*, const uint8_t*, const uint8_t*, size_t, uint8_t*) = &aes256_gcm_inplace_oneshot;
+    double best_time = measure_time(inplace_ptr, "aes_gcm in-place", data.data(), key.data(), iv.data(), N, tag);
+
+    return {"aes_gcm in-place", N, best_time};
+}
+
+// Расшифрование 2 МБ с проверкой тега; ключ готовится в каждом вызове, как в aes256_gcm
+static Status aes256_gcm_decrypt_oneshot(const uint8_t* ciphertext, uint8_t* plaintext,
+                                         const uint8_t* key, const uint8_t* iv, size_t len, const uint8_t* tag) {
+    Aes256GcmContext ctx;
+    aes256_gcm_init(&ctx, key);
+    return aes256_gcm_decrypt(&ctx, ciphertext, plaintext, iv, len, nullptr, 0, tag);
+}
+
+BenchmarkResult benchmark_aes256_gcm_decrypt() {
+    int N = 2097152;
+    std::vector<uint8_t> plaintext(N, 7);
+    std::vector<uint8_t> ciphertext(N, 0);
+    std::vector<uint8_t> key(32, 1);
+    std::vector<uint8_t> iv(12, 2);
+    uint8_t tag[16];
+    aes256_gcm(plaintext.data(), ciphertext.data(), key.data(), iv.data(), N, tag);
+
+    Status (* volatile decrypt_ptr)(const uint8_t*, uint8_t*, const uint8_t*, const uint8_t*, size_t, const uint8_t*) = &aes256_gcm_decrypt_oneshot;
+    double best_time = measure_time(decrypt_ptr, "aes_gcm decrypt", ciphertext.data(), plaintext.data(), key.data(), iv.data(), N, (const uint8_t*)tag);
+
+    return {"aes_gcm decrypt", N, best_time};
+}
+
+// Те же 2 МБ цепочкой буферов: заголовок в AAD, данные фрагментами по 64 КБ + 13 байт,
+// выход другой нарезкой, так что блоки режутся границами сегментов
+struct IovMessage {
+    std::vector<uint8_t> plaintext;
+    std::vector<uint8_t> ciphertext;
+    std::vector<uint8_t> header;
+    std::vector<uint8_t> key;
+    std::vector<uint8_t> iv;
+    std::vector<Aes256GcmIovec> aad_iov;
+    std::vector<Aes256GcmIovec> in_iov;
+    std::vector<Aes256GcmIovec> out_iov;
+    Aes256GcmContext ctx;
+    uint8_t tag[16];
+
+    IovMessage() : plaintext(2097152, 7), ciphertext(plaintext.size()), header(40, 3), key(32, 1), iv(12, 2) {
+        aes256_gcm_init(&ctx, key.data());
+        Aes256GcmIovec h = {header.data(), header.size()};
+        aad_iov.push_back(h);
+        for (size_t pos = 0; pos < plaintext.size(); pos += 65549) {
+            Aes256GcmIovec seg = {plaintext.data() + pos, std::min<size_t>(65549, plaintext.size() - pos)};
+            in_iov.push_back(seg);
+        }
+        for (size_t pos = 0; pos < ciphertext.size(); pos += 262147) {
+            Aes256GcmIovec seg = {ciphertext.data() + pos, std::min<size_t>(262147, ciphertext.size() - pos)};
+            out_iov.push_back(seg);
+        }
+    }
+};
+
+static Status encrypt_iov_message(IovMessage* m) {
+    return aes256_gcm_encrypt_iov(&m->ctx, m->iv.data(), m->aad_iov.data(), m->aad_iov.size(), m->in_iov.data(),
+                                  m->in_iov.size(), m->out_iov.data(), m->out_iov.size(), m->tag);
+}
+
+BenchmarkResult benchmark_aes256_gcm_iov() {
+    IovMessage message;
+
+    Status (* volatile func_ptr)(IovMessage*) = &encrypt_iov_message;
+    double best_time = measure_time(func_ptr, "aes_gcm iovec", &message);
+
+    return {"aes_gcm iovec", (int)message.plaintext.size(), best_time};
+}
+
+// 2 МБ короткими записями одного ключа: поштучные вызовы aes256_gcm против батча
+struct SmallRecords {
+    size_t record_len;
+    std::vector<uint8_t> plaintext;
+    std::vector<uint8_t> ciphertext;
+    std::vector<uint8_t> tags;
+    std::vector<uint8_t> key;
+    std::vector<uint8_t> iv;
+    std::vector<Aes256GcmBatchEntry> entries;
+
+    explicit SmallRecords(size_t len)
+        : record_len(len), plaintext(2097152 / len * len, 7), ciphertext(plaintext.size()),
+          tags(2097152 / len * 16), key(32, 1), iv(12, 2), entries(2097152 / len) {
+        for (size_t i = 0; i < entries.size(); i++) {
+            Aes256GcmBatchEntry e = {key.data(), iv.data(), plaintext.data() + i * len,
+                                     ciphertext.data() + i * len, len, tags.data() + i * 16};
+            entries[i] = e;
+        }
+    }
+};
+
+static Status encrypt_records_per_call(SmallRecords* r) {
+    Status status = STATUS_OK;
+    for (size_t i = 0; i < r->entries.size(); i++) {
+        const Aes256GcmBatchEntry& e = r->entries[i];
+        status = (Status)(status | aes256_gcm(e.plaintext, e.ciphertext, e.key, e.iv, e.len, e.tag));
+    }
+    return status;
+}
+
+static Status encrypt_records_batch(SmallRecords* r) {
+    return aes256_gcm_encrypt_batch(r->entries.data(), r->entries.size());
+}
+
+BenchmarkResult benchmark_aes256_gcm_records(size_t len, bool batch, const char* name) {
+    SmallRecords records(len);
+
+    Status (* volatile func_ptr)(SmallRecords*) = batch ? &encrypt_records_batch : &encrypt_records_per_call;
+    double best_time = measure_time(func_ptr, name, &records);
+
+    return {name, (int)records.plaintext.size(), best_time};
+}
+
+// 64 МБ объект в контейнере с чанками по 64 КБ: целиком и по одному чанку
+struct ChunkedObject {
+    std::vector<uint8_t> plaintext;
+    std::vector<uint8_t> container;
+    std::vector<uint8_t> output;
+    std::vector<size_t> order;
+    std::vector<uint8_t> key;
+    Aes256GcmContext ctx;
+    Aes256GcmChunked chunked;
+
+    ChunkedObject(bool random_order)
+        : plaintext(64 * 1024 * 1024, 7), output(plaintext.size()), order(plaintext.size() / (64 * 1024)), key(32, 1) {
+        uint8_t prefix[7] = {2, 2, 2, 2, 2, 2, 2};
+        uint8_t header[AES256_GCM_CHUNKED_HEADER_LEN];
+        aes256_gcm_init(&ctx, key.data());
+        aes256_gcm_chunked_writer_init(&chunked, &ctx, prefix, 64 * 1024, header);
+        container.resize(aes256_gcm_chunked_size(&chunked, plaintext.size()));
+        aes256_gcm_chunked_encrypt(&chunked, plaintext.data(), plaintext.size(), container.data());
+
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+        if (random_order) {
+            std::mt19937 gen(5);
+            std::shuffle(order.begin(), order.end(), gen);
+        }
+    }
+};
+
+static Status chunked_encrypt_all(ChunkedObject* o) {
+    return aes256_gcm_chunked_encrypt(&o->chunked, o->plaintext.data(), o->plaintext.size(), o->container.data());
+}
+
+static Status chunked_decrypt_all(ChunkedObject* o) {
+    size_t len = 0;
+    return aes256_gcm_chunked_decrypt(&o->ctx, o->container.data(), o->container.size(), o->output.data(), &len);
+}
+
+// Чтение по одному чанку в порядке order, как при доступе к произвольным смещениям
+static Status chunked_read_chunks(ChunkedObject* o) {
+    Status status = STATUS_OK;
+    for (size_t i = 0; i < o->order.size(); i++) {
+        size_t len = 0;
+        size_t index = o->order[i];
+        status = (Status)(status | aes256_gcm_chunked_read_at(&o->chunked, o->container.data(), o->container.size(), index,
+                                                              o->output.data() + index * 64 * 1024, &len));
+    }
+    return status;
+}
+
+BenchmarkResult benchmark_aes256_gcm_chunked(Status (*func)(ChunkedObject*), bool random_order, const char* name) {
+    ChunkedObject object(random_order);
+
+    Status (* volatile func_ptr)(ChunkedObject*) = func;
+    double best_time = measure_time(func_ptr, name, &object);
+
+    return {name, (int)object.plaintext.size(), best_time};
+}
+
+// Задержка одного вызова aes256_gcm на пакетах типичных размеров
+LatencyResult benchmark_aes256_gcm_latency(size_t len, const char* name) {
+    const int calls = 200000;
+    std::vector<uint8_t> plaintext(len, 7);
+    std::vector<uint8_t> ciphertext(len, 0);
+    std::vector<uint8_t> key(32, 1);
+    std::vector<uint8_t> iv(12, 2);
+    std::vector<double> times(calls);
+    uint8_t tag[16];
+
+    Status (* volatile aes256_gcm_ptr)(const uint8_t*, uint8_t*, const uint8_t*, const uint8_t*, size_t, uint8_t*) = &aes256_gcm;
+    for (int i = 0; i < 1000; i++) {
+        aes256_gcm_ptr(plaintext.data(), ciphertext.data(), key.data(), iv.data(), len, tag);
+    }
+
+    for (int i = 0; i < calls; i++) {
+        std::chrono::high_resolution_clock::time_point start_time = std::chrono::high_resolution_clock::now();
+        aes256_gcm_ptr(plaintext.data(), ciphertext.data(), key.data(), iv.data(), len, tag);
+        std::chrono::high_resolution_clock::time_point end_time = std::chrono::high_resolution_clock::now();
+        times[i] = std::chrono::duration<double, std::nano>(end_time - start_time).count();
+    }
+
+    std::sort(times.begin(), times.end());
+    return {name, calls, times[calls / 2], times[(size_t)calls * 99 / 100]};
+}
+
+// Задержка crc32_combine при склейке блоков: отдельный вызов короче разрешения
+// таймера, поэтому замер - по пачке из 64 вызовов с разными длинами
+LatencyResult benchmark_crc32_combine_latency() {
+    const int calls = 100000;
+    const int batch = 64;
+    std::vector<double> times(calls);
+    uint32_t (* volatile combine_ptr)(uint32_t, uint32_t, size_t) = &crc32_combine;
+    uint32_t crc = 0;
+
+    for (int i = 0; i < calls; i++) {
+        std::chrono::high_resolution_clock::time_point start_time = std::chrono::high_resolution_clock::now();
+        for (int j = 0; j < batch; j++) {
+            crc = combine_ptr(crc, (uint32_t)j, 8192 * 1024 + (size_t)j * 4099);
+        }
+        std::chrono::high_resolution_clock::time_point end_time = std::chrono::high_resolution_clock::now();
+        times[i] = std::chrono::duration<double, std::nano>(end_time - start_time).count() / batch;
+    }
+
+    std::sort(times.begin(), times.end());
+    return {"crc32_combine", calls * batch, times[calls / 2], times[(size_t)calls * 99 / 100]};
+}
+
+// ECB на тех же 2 МБ; ключ готовится в каждом вызове, как в aes256_gcm
+static Status aes256_ecb_oneshot(const uint8_t* in, uint8_t* out, const uint8_t* key, size_t len, bool decrypt) {
+    Aes256EcbContext ctx;
+    aes256_ecb_init(&ctx, key);
+    return decrypt ? aes256_ecb_decrypt(&ctx, in, out, len) : aes256_ecb_encrypt(&ctx, in, out, len);
+}
+
+BenchmarkResult benchmark_aes256_ecb(bool decrypt, const char* name) {
+    int N = 2097152;
+    std::vector<uint8_t> input(N, 7);
+    std::vector<uint8_t> output(N, 0);
+    std::vector<uint8_t> key(32, 1);
+
+    Status (* volatile ecb_ptr)(const uint8_t*, uint8_t*, const uint8_t*, size_t, bool) = &aes256_ecb_oneshot;
+    double best_time = measure_time(ecb_ptr, name, input.data(), output.data(), key.data(), N, decrypt);
+
+    return {name, N, best_time};
+}
+
 BenchmarkResult benchmark_crc32() {
     int N = 500000000;
     std::vector<uint8_t> data(N);
@@ -128,17 +510,140 @@ BenchmarkResult benchmark_crc32() {
 }
 
 
+// Те же 500 МБ, поданные потоком по 4 КБ через crc32_update
+static Status crc32_stream_pages(const uint8_t* data, size_t data_len, uint32_t* result) {
+    const size_t page = 4096;
+    uint32_t crc = 0;
+    for (size_t pos = 0; pos < data_len; pos += page) {
+        size_t n = std::min(page, data_len - pos);
+        if (crc32_update(crc, data + pos, n, &crc) != STATUS_OK) {
+            return STATUS_ERROR;
+        }
+    }
+    *result = crc;
+    return STATUS_OK;
+}
+
+BenchmarkResult benchmark_crc32_stream() {
+    int N = 500000000;
+    std::vector<uint8_t> data(N);
+    uint32_t result;
+
+    Status (* volatile func_ptr)(const uint8_t*, size_t, uint32_t*) = &crc32_stream_pages;
+    double best_time = measure_time(func_ptr, "crc32 update 4K", data.data(), N, &result);
+
+    return {"crc32 update 4K", N, best_time};
+}
+
+// Тот же прогон с принудительно выбранным ядром CRC32
+BenchmarkResult benchmark_crc32_backend(Crc32Backend backend, const char* name) {
+    if (crc32_set_backend(backend) != STATUS_OK) {
+        return {name, 0, 0.0};
+    }
+    BenchmarkResult result = benchmark_crc32();
+    result.function_name = name;
+    crc32_set_backend(CRC32_BACKEND_AUTO);
+    return result;
+}
+
+BenchmarkResult benchmark_crc32c() {
+    int N = 500000000;
+    std::vector<uint8_t> data(N);
+    uint32_t result;
+
+    Status (* volatile crc32c_ptr)(const uint8_t*, size_t, uint32_t*) = &crc32c;
+    double best_time = measure_time(crc32c_ptr, "crc32c", data.data(), N, &result);
+
+    return {"crc32c", N, best_time};
+}
+
+BenchmarkResult benchmark_crc32c_backend(Crc32cBackend backend, const char* name) {
+    if (crc32c_set_backend(backend) != STATUS_OK) {
+        return {name, 0, 0.0};
+    }
+    BenchmarkResult result = benchmark_crc32c();
+    result.function_name = name;
+    crc32c_set_backend(CRC32C_BACKEND_AUTO);
+    return result;
+}
+
+// crc32 на размерах от 4 КБ до 1 ГБ в одном потоке и на всех: показывает, с какого
+// размера окупается разбиение и как оно масштабируется. Буфер общий, меньшие
+// размеры - его префиксы, поэтому они считаются из кэша
+int benchmark_crc32_sweep(ScalingResult* results) {
+    static const size_t sizes[] = {4096, 65536, 1 << 20, 16 << 20, 256 << 20, 1 << 30};
+    static const char* names[] = {"4 KB", "64 KB", "1 MB", "16 MB", "256 MB", "1 GB"};
+    const int count = sizeof(sizes) / sizeof(sizes[0]);
+    const int max_threads = omp_get_max_threads();
+    std::vector<uint8_t> data(sizes[count - 1], 1);
+    uint32_t result;
+
+    Status (* volatile crc32_ptr)(const uint8_t*, size_t, uint32_t*) = &crc32;
+    for (int i = 0; i < count; i++) {
+        omp_set_num_threads(1);
+        double single_time = measure_time(crc32_ptr, "crc32", data.data(), sizes[i], &result);
+        omp_set_num_threads(max_threads);
+        double multi_time = measure_time(crc32_ptr, "crc32", data.data(), sizes[i], &result);
+        results[i] = {names[i], sizes[i], sizes[i] / single_time / 1e9, sizes[i] / multi_time / 1e9};
+    }
+
+    return count;
+}
+
 int run_performance() {
-    BenchmarkResult results[7];
+    BenchmarkResult results[38];
     results[0] = benchmark_bits();
     results[1] = benchmark_uniform();
     results[2] = benchmark_norm();
     results[3] = benchmark_exponential();
     results[4] = benchmark_bernoulli();
-    results[5] = benchmark_aes256_gcm();
-    results[6] = benchmark_crc32();
+    results[5] = benchmark_bytes();
+    results[6] = benchmark_aes256_gcm();
+    results[7] = benchmark_chacha20_poly1305();
+    results[8] = benchmark_aes256_gcm_backend(AES_BACKEND_BYTEWISE, "aes_gcm bytewise");
+    results[9] = benchmark_aes256_gcm_backend(AES_BACKEND_TTABLE, "aes_gcm ttable");
+    results[10] = benchmark_aes256_gcm_backend(AES_BACKEND_BITSLICED, "aes_gcm bitsliced");
+    results[11] = benchmark_aes256_gcm_backend(AES_BACKEND_AESNI, "aes_gcm aesni");
+    results[12] = benchmark_aes256_gcm_backend(AES_BACKEND_VAES, "aes_gcm vaes");
+    results[13] = benchmark_aes256_gcm_ghash(GHASH_BACKEND_BITWISE, "ghash bitwise");
+    results[14] = benchmark_aes256_gcm_ghash(GHASH_BACKEND_SHOUP4, "ghash shoup4");
+    results[15] = benchmark_aes256_gcm_ghash(GHASH_BACKEND_SHOUP8, "ghash shoup8");
+    results[16] = benchmark_aes256_gcm_ghash(GHASH_BACKEND_CLMUL, "ghash clmul");
+    results[17] = benchmark_aes256_gcm_ghash(GHASH_BACKEND_VPCLMUL, "ghash vpclmul");
+    results[18] = benchmark_aes256_gcm_stream();
+    results[19] = benchmark_aes256_gcm_inplace();
+    results[20] = benchmark_aes256_gcm_decrypt();
+    results[21] = benchmark_aes256_gcm_iov();
+    results[22] = benchmark_aes256_gcm_records(64, false, "gcm 64B per-call");
+    results[23] = benchmark_aes256_gcm_records(64, true, "gcm 64B batch");
+    results[24] = benchmark_aes256_gcm_records(1500, false, "gcm 1500B per-call");
+    results[25] = benchmark_aes256_gcm_records(1500, true, "gcm 1500B batch");
+    results[26] = benchmark_aes256_gcm_chunked(chunked_encrypt_all, false, "chunked encrypt");
+    results[27] = benchmark_aes256_gcm_chunked(chunked_decrypt_all, false, "chunked decrypt");
+    results[28] = benchmark_aes256_gcm_chunked(chunked_read_chunks, false, "chunked seq read");
+    results[29] = benchmark_aes256_gcm_chunked(chunked_read_chunks, true, "chunked rand read");
+    results[30] = benchmark_aes256_ecb(false, "aes256_ecb enc");
+    results[31] = benchmark_aes256_ecb(true, "aes256_ecb dec");
+    results[32] = benchmark_crc32();
+    results[33] = benchmark_crc32_backend(CRC32_BACKEND_SLICING16, "crc32 slicing16");
+    results[34] = benchmark_crc32_backend(CRC32_BACKEND_CLMUL, "crc32 clmul");
+    results[35] = benchmark_crc32_stream();
+    results[36] = benchmark_crc32c();
+    results[37] = benchmark_crc32c_backend(CRC32C_BACKEND_SLICING16, "crc32c slicing16");
+    
+    print_performance_table(results, 38);
+    
+    LatencyResult latencies[4];
+    latencies[0] = benchmark_aes256_gcm_latency(64, "aes256_gcm 64B");
+    latencies[1] = benchmark_aes256_gcm_latency(512, "aes256_gcm 512B");
+    latencies[2] = benchmark_aes256_gcm_latency(1500, "aes256_gcm 1500B");
+    latencies[3] = benchmark_crc32_combine_latency();
+    
+    print_latency_table(latencies, 4);
     
-    print_performance_table(results, 7);
+    ScalingResult sweep[6];
+    int sweep_count = benchmark_crc32_sweep(sweep);
+    print_scaling_table("crc32 size sweep", sweep, sweep_count, omp_get_max_threads());
     
     return 0;
 }
@@ -16,6 +16,8 @@ int parse_arguments(int argc, char **argv) {
             return 1;
         } else if (strcmp(argv[i], "all") == 0) {
             return 2;
+        } else if (strcmp(argv[i], "ct") == 0) {
+            return 3;
         } else {
             return -1;
         }
@@ -40,8 +42,12 @@ int run_tests(int argc, char **argv) {
             };
             break;
         }
+        case 3: {
+            run_constant_time();
+            break;
+        }
         default: {
-            printf("Using: %s correctness|performance|all\n", argv[0]);
+            printf("Using: %s correctness|performance|all|ct\n", argv[0]);
         }
     }
     return 0;
@@ -9,7 +9,10 @@
 #define NUM_OF_TESTCASES_EXPONENTIAL 10
 #define NUM_OF_TESTCASES_BERNOULLI 10
 #define NUM_OF_TESTCASES_AES 4
+#define NUM_OF_TESTCASES_AES_AAD 3
+#define NUM_OF_TESTCASES_CHACHA 2
 #define NUM_OF_TESTCASES_CRC32 10
+#define NUM_OF_TESTCASES_CRC32C 7
 
 typedef struct {
     size_t n;
@@ -58,6 +61,16 @@ typedef struct {
     std::vector<uint8_t> tag;
 } TestCaseAES;
 
+typedef struct {
+    size_t n;
+    std::vector<uint8_t> key;
+    std::vector<uint8_t> iv;
+    std::vector<uint8_t> aad;
+    std::vector<uint8_t> plaintext;
+    std::vector<uint8_t> ciphertext;
+    std::vector<uint8_t> tag;
+} TestCaseAESAAD;
+
 typedef struct {
     std::string input;
     uint32_t result;
@@ -69,7 +82,25 @@ bool test_norm();
 bool test_exponential();
 bool test_bernoulli();
 bool test_aes256_gcm();
+bool test_aes256_gcm_context();
+bool test_aes256_gcm_backends();
+bool test_aes256_gcm_stream();
+bool test_aes256_gcm_aad();
+bool test_aes256_gcm_decrypt();
+bool test_aes256_gcm_threads();
+bool test_aes256_gcm_inplace();
+bool test_aes256_gcm_batch();
+bool test_aes256_gcm_iov();
+bool test_aes256_gcm_chunked();
+bool test_aes256_ecb();
+bool test_aes256_ctr_drbg();
+bool test_chacha20_poly1305();
 bool test_crc32();
+bool test_crc32c();
+bool test_crc32_update();
+bool test_crc32_threads();
+bool test_crc32_combine();
 
 int run_performance();
 int run_correctness();
+int run_constant_time();
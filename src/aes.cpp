@@ -5,6 +5,7 @@
 #include <omp.h>
 
 #include "solution.hpp"
+#include "aes_impl.hpp"
 
 // Предвычисленная таблица S-box для AES (256 байт)
 static const uint8_t SBOX[256] = {
@@ -26,6 +27,26 @@ static const uint8_t SBOX[256] = {
     0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
 };
 
+// Обратный S-box для расшифрования (ECB)
+const uint8_t INV_SBOX[256] = {
+    0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
+    0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
+    0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
+    0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
+    0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
+    0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
+    0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
+    0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
+    0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
+    0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
+    0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
+    0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
+    0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
+    0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
+    0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
+    0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d
+};
+
 // Таблица умножения на 2 в GF(2^8)
 static const uint8_t GMUL2[256] = {
     0x00, 0x02, 0x04, 0x06, 0x08, 0x0a, 0x0c, 0x0e, 0x10, 0x12, 0x14, 0x16, 0x18, 0x1a, 0x1c, 0x1e,
@@ -162,11 +183,11 @@ static void key_expansion(const uint8_t *key, uint8_t *w) {
     }
 }
 
-void aes256_encrypt(const uint8_t *in, uint8_t *out, const uint8_t *key) {
-    uint8_t state[16], w[240];
+// Шифрование одного блока уже развёрнутым ключом
+static void aes256_encrypt_block(const uint8_t *in, uint8_t *out, const uint8_t *w) {
+    uint8_t state[16];
     
     memcpy(state, in, 16);
-    key_expansion(key, w);
     
     add_round_key(state, w);
     
@@ -184,6 +205,72 @@ void aes256_encrypt(const uint8_t *in, uint8_t *out, const uint8_t *key) {
     memcpy(out, state, 16);
 }
 
+void aes256_encrypt(const uint8_t *in, uint8_t *out, const uint8_t *key) {
+    uint8_t w[240];
+    key_expansion(key, w);
+    aes256_encrypt_block(in, out, w);
+}
+
+static void inv_sub_bytes(uint8_t *s) {
+    for (int i = 0; i < 16; i++)
+        s[i] = INV_SBOX[s[i]];
+}
+
+static inline void inv_shift_rows(uint8_t *s) {
+    uint8_t t;
+    t = s[13]; s[13] = s[9]; s[9] = s[5]; s[5] = s[1]; s[1] = t;
+    t = s[2]; s[2] = s[10]; s[10] = t;
+    t = s[6]; s[6] = s[14]; s[14] = t;
+    t = s[3]; s[3] = s[7]; s[7] = s[11]; s[11] = s[15]; s[15] = t;
+}
+
+// InvMixColumns = MixColumns o [05 00 04 00]: хватает таблицы GMUL2
+static void inv_mix_columns(uint8_t *s) {
+    for (int i = 0; i < 4; i++) {
+        uint8_t *c = s + i * 4;
+        uint8_t u = GMUL2[GMUL2[c[0] ^ c[2]]];
+        uint8_t v = GMUL2[GMUL2[c[1] ^ c[3]]];
+        c[0] ^= u;
+        c[1] ^= v;
+        c[2] ^= u;
+        c[3] ^= v;
+    }
+    mix_columns(s);
+}
+
+// Расшифрование одного блока прямым обратным шифром на ключах шифрования
+static void aes256_decrypt_block(const uint8_t *in, uint8_t *out, const uint8_t *w) {
+    uint8_t state[16];
+    
+    memcpy(state, in, 16);
+    
+    add_round_key(state, w + 14 * 16);
+    
+    for (int round = 13; round > 0; round--) {
+        inv_shift_rows(state);
+        inv_sub_bytes(state);
+        add_round_key(state, w + round * 16);
+        inv_mix_columns(state);
+    }
+    
+    inv_shift_rows(state);
+    inv_sub_bytes(state);
+    add_round_key(state, w);
+    
+    memcpy(out, state, 16);
+}
+
+// Ключи эквивалентного обратного шифра (как у AESDEC): обратный порядок
+// раундов и InvMixColumns на раундах 1..13
+static void decrypt_key_expansion(const uint8_t *w, uint8_t *dw) {
+    memcpy(dw, w + 14 * 16, 16);
+    for (int round = 1; round < 14; round++) {
+        memcpy(dw + round * 16, w + (14 - round) * 16, 16);
+        inv_mix_columns(dw + round * 16);
+    }
+    memcpy(dw + 14 * 16, w, 16);
+}
+
 static void gmul_block(const uint8_t *a, const uint8_t *b, uint8_t *result) {
     uint8_t v[16];
     uint8_t z[16] = {0};
@@ -213,33 +300,121 @@ static void gmul_block(const uint8_t *a, const uint8_t *b, uint8_t *result) {
     memcpy(result, z, 16);
 }
 
-static void ghash(const uint8_t *h, const uint8_t *aad, size_t aad_len,
-                  const uint8_t *ciphertext, size_t ciphertext_len, uint8_t *tag) {
-    uint8_t x[16] = {0};
-    uint8_t block[16];
+// x = (x ^ block) * H для nblocks полных блоков выбранной реализацией
+static void ghash_blocks(const Aes256GcmContext *ctx, uint8_t *x, const uint8_t *data, size_t nblocks) {
+    switch (ctx->ghash_impl) {
+#if AES_HAVE_X86
+    case GHASH_BACKEND_CLMUL:
+        clmul_ghash(ctx->h_powers, x, data, nblocks);
+        break;
+    case GHASH_BACKEND_VPCLMUL:
+        vpclmul_ghash(ctx->h_powers, x, data, nblocks);
+        break;
+#endif
+    case GHASH_BACKEND_SHOUP4:
+        shoup4_ghash(ctx->ghash_table, x, data, nblocks);
+        break;
+    case GHASH_BACKEND_SHOUP8:
+        shoup8_ghash(ctx->ghash_table, x, data, nblocks);
+        break;
+    default:
+        for (size_t i = 0; i < nblocks; i++) {
+            for (int j = 0; j < 16; j++) {
+                x[j] ^= data[i * 16 + j];
+            }
+            gmul_block(x, ctx->h, x);
+        }
+        break;
+    }
+}
+
+// out = a * b в GF(2^128), для объединения частичных GHASH
+static void gf_mul(const Aes256GcmContext *ctx, const uint8_t *a, const uint8_t *b, uint8_t *out) {
+#if AES_HAVE_X86
+    if (ctx->ghash_impl == GHASH_BACKEND_CLMUL || ctx->ghash_impl == GHASH_BACKEND_VPCLMUL) {
+        clmul_gf128_mul(a, b, out);
+        return;
+    }
+#endif
+    gf128_mul(a, b, out);
+}
+
+// out = H^n возведением в квадрат и умножением
+static void h_pow(const Aes256GcmContext *ctx, uint64_t n, uint8_t *out) {
+    uint8_t base[16];
+    uint8_t r[16] = {0x80}; // единица поля: коэффициент при x^0 - старший бит первого байта
+    memcpy(base, ctx->h, 16);
     
-    for (size_t i = 0; i < aad_len; i += 16) {
-        size_t block_len = (i + 16 <= aad_len) ? 16 : aad_len - i;
-        memset(block, 0, 16);
-        memcpy(block, aad + i, block_len);
-        
-        for (int j = 0; j < 16; j++) {
-            x[j] ^= block[j];
+    while (n) {
+        if (n & 1) {
+            gf_mul(ctx, r, base, r);
+        }
+        n >>= 1;
+        if (n) {
+            gf_mul(ctx, base, base, base);
         }
-        gmul_block(x, h, x);
     }
+    memcpy(out, r, 16);
+}
+
+// Меньше этого GHASH считается в одном потоке
+static const size_t GHASH_PARALLEL_MIN_BLOCKS = 4096;
+
+// Параллельный GHASH: X = x * H^n ^ sum(d_i * H^(n-i)) линеен, поэтому каждый поток
+// сворачивает свой отрезок [begin, end) с нуля, а результат домножается на H^(n-end).
+// Начальное значение x учитывается в отрезке нулевого потока
+static void ghash_blocks_parallel(const Aes256GcmContext *ctx, uint8_t *x, const uint8_t *data, size_t nblocks) {
+    if (nblocks < GHASH_PARALLEL_MIN_BLOCKS || omp_get_max_threads() == 1) {
+        ghash_blocks(ctx, x, data, nblocks);
+        return;
+    }
+    
+    uint8_t acc[16] = {0};
     
-    for (size_t i = 0; i < ciphertext_len; i += 16) {
-        size_t block_len = (i + 16 <= ciphertext_len) ? 16 : ciphertext_len - i;
-        memset(block, 0, 16);
-        memcpy(block, ciphertext + i, block_len);
+    #pragma omp parallel
+    {
+        size_t num_threads = omp_get_num_threads();
+        size_t t = omp_get_thread_num();
+        size_t begin = nblocks * t / num_threads;
+        size_t end = nblocks * (t + 1) / num_threads;
+        
+        uint8_t y[16] = {0};
+        if (t == 0) {
+            memcpy(y, x, 16);
+        }
+        ghash_blocks(ctx, y, data + begin * 16, end - begin);
+        
+        if (end < nblocks) {
+            uint8_t hp[16];
+            h_pow(ctx, nblocks - end, hp);
+            gf_mul(ctx, y, hp, y);
+        }
         
+        #pragma omp critical
         for (int j = 0; j < 16; j++) {
-            x[j] ^= block[j];
+            acc[j] ^= y[j];
         }
-        gmul_block(x, h, x);
     }
     
+    memcpy(x, acc, 16);
+}
+
+// Неполный последний блок дополняется нулями
+static void ghash_update(const Aes256GcmContext *ctx, uint8_t *x, const uint8_t *data, size_t len) {
+    size_t full = len / 16;
+    ghash_blocks_parallel(ctx, x, data, full);
+    
+    if (len % 16) {
+        uint8_t block[16] = {0};
+        memcpy(block, data + full * 16, len % 16);
+        ghash_blocks(ctx, x, block, 1);
+    }
+}
+
+// Завершающий блок GHASH с длинами AAD и шифртекста в битах
+static void ghash_lengths(const Aes256GcmContext *ctx, uint8_t *x, size_t aad_len, size_t ciphertext_len) {
+    uint8_t block[16];
+    
     uint64_t aad_len_bits = ((uint64_t)aad_len) * 8;
     uint64_t ciphertext_len_bits = ((uint64_t)ciphertext_len) * 8;
     
@@ -249,12 +424,7 @@ static void ghash(const uint8_t *h, const uint8_t *aad, size_t aad_len,
         block[15 - i] = (ciphertext_len_bits >> (i * 8)) & 0xff;
     }
     
-    for (int j = 0; j < 16; j++) {
-        x[j] ^= block[j];
-    }
-    gmul_block(x, h, x);
-    
-    memcpy(tag, x, 16);
+    ghash_blocks(ctx, x, block, 1);
 }
 
 static inline void inc32(uint8_t *counter) {
@@ -271,75 +441,1177 @@ static inline void inc32(uint8_t *counter) {
     counter[15] = val & 0xff;
 }
 
-Status aes256_gcm(const uint8_t* plaintext, uint8_t* ciphertext,
-                  const uint8_t* key, const uint8_t* iv, size_t plaintext_len, uint8_t* tag) {
-    if (!key || !iv || !tag) {
+// counter + n по младшим 32 битам (big-endian), как n-кратный inc32
+static inline void ctr_add(const uint8_t *counter, uint32_t n, uint8_t *out) {
+    memcpy(out, counter, 16);
+    uint32_t val = ((uint32_t)counter[12] << 24) |
+                   ((uint32_t)counter[13] << 16) |
+                   ((uint32_t)counter[14] << 8) |
+                   ((uint32_t)counter[15]);
+    val += n;
+    out[12] = (val >> 24) & 0xff;
+    out[13] = (val >> 16) & 0xff;
+    out[14] = (val >> 8) & 0xff;
+    out[15] = val & 0xff;
+}
+
+static void encrypt_block(const Aes256GcmContext *ctx, const uint8_t *in, uint8_t *out) {
+    switch (ctx->aes_impl) {
+#if AES_HAVE_X86
+    case AES_BACKEND_AESNI:
+    case AES_BACKEND_VAES:
+        aesni_encrypt_block(ctx->round_keys, in, out);
+        break;
+#endif
+    case AES_BACKEND_BITSLICED:
+        bitsliced_encrypt_block(ctx->bs_round_keys, in, out);
+        break;
+    case AES_BACKEND_TTABLE:
+        ttable_encrypt_block(ctx->round_keys, in, out);
+        break;
+    default:
+        aes256_encrypt_block(in, out, ctx->round_keys);
+        break;
+    }
+}
+
+static void bytewise_ctr32(const uint8_t *w, const uint8_t *counter,
+                           const uint8_t *in, uint8_t *out, size_t len) {
+    uint8_t block_counter[16], ks[16];
+    memcpy(block_counter, counter, 16);
+    
+    for (size_t i = 0; i < len; i += 16) {
+        aes256_encrypt_block(block_counter, ks, w);
+        inc32(block_counter);
+        
+        size_t block_len = (i + 16 <= len) ? 16 : len - i;
+        for (size_t j = 0; j < block_len; j++) {
+            out[i + j] = in[i + j] ^ ks[j];
+        }
+    }
+}
+
+// out = in ^ keystream, начиная со счётчика counter; len может быть не кратен 16
+static void ctr32_xor(const Aes256GcmContext *ctx, const uint8_t *counter,
+                      const uint8_t *in, uint8_t *out, size_t len) {
+    switch (ctx->aes_impl) {
+#if AES_HAVE_X86
+    case AES_BACKEND_AESNI:
+        aesni_ctr32(ctx->round_keys, counter, in, out, len);
+        break;
+    case AES_BACKEND_VAES:
+        vaes_ctr32(ctx->round_keys, counter, in, out, len);
+        break;
+#endif
+    case AES_BACKEND_BITSLICED:
+        bitsliced_ctr32(ctx->bs_round_keys, counter, in, out, len);
+        break;
+    case AES_BACKEND_TTABLE:
+        ttable_ctr32(ctx->round_keys, counter, in, out, len);
+        break;
+    default:
+        bytewise_ctr32(ctx->round_keys, counter, in, out, len);
+        break;
+    }
+}
+
+static bool aes_backend_supported(AesBackend backend) {
+    switch (backend) {
+    case AES_BACKEND_AUTO:
+    case AES_BACKEND_BYTEWISE:
+    case AES_BACKEND_TTABLE:
+    case AES_BACKEND_BITSLICED:
+        return true;
+#if AES_HAVE_X86
+    case AES_BACKEND_AESNI: {
+        static const bool has_aesni = cpu_has_aesni();
+        return has_aesni;
+    }
+    case AES_BACKEND_VAES: {
+        static const bool has_vaes = cpu_has_vaes();
+        return has_vaes;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+static bool ghash_backend_supported(GhashBackend backend) {
+    switch (backend) {
+    case GHASH_BACKEND_AUTO:
+    case GHASH_BACKEND_BITWISE:
+    case GHASH_BACKEND_SHOUP4:
+    case GHASH_BACKEND_SHOUP8:
+        return true;
+#if AES_HAVE_X86
+    case GHASH_BACKEND_CLMUL: {
+        static const bool has_pclmul = cpu_has_pclmul();
+        return has_pclmul;
+    }
+    case GHASH_BACKEND_VPCLMUL: {
+        static const bool has_vpclmul = cpu_has_vaes();
+        return has_vpclmul;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+// Реализации для новых контекстов; AUTO раскрывается в aes256_gcm_init
+static AesBackend selected_aes_backend = AES_BACKEND_AUTO;
+static GhashBackend selected_ghash_backend = GHASH_BACKEND_AUTO;
+
+Status aes256_set_backend(AesBackend backend) {
+    if (!aes_backend_supported(backend)) {
+        return STATUS_ERROR;
+    }
+    selected_aes_backend = backend;
+    return STATUS_OK;
+}
+
+Status aes256_gcm_set_ghash_backend(GhashBackend backend) {
+    if (!ghash_backend_supported(backend)) {
         return STATUS_ERROR;
     }
+    selected_ghash_backend = backend;
+    return STATUS_OK;
+}
+
+// Самый широкий аппаратный вариант (VAES, затем AES-NI), иначе битслайсинг:
+// он быстрее табличных вариантов и не зависит по времени от данных
+static AesBackend resolve_aes_backend() {
+    AesBackend backend = selected_aes_backend;
+    if (backend == AES_BACKEND_AUTO) {
+        if (aes_backend_supported(AES_BACKEND_VAES)) {
+            backend = AES_BACKEND_VAES;
+        } else if (aes_backend_supported(AES_BACKEND_AESNI)) {
+            backend = AES_BACKEND_AESNI;
+        } else {
+            backend = AES_BACKEND_BITSLICED;
+        }
+    }
+    return backend;
+}
+
+// memset перед концом жизни буфера компилятор вправе выбросить. Барьер с buf на
+// входе и "memory" в списке изменённого заставляет считать обнулённую память
+// прочитанной (как memzero_explicit в Linux); без GCC-расширений - побайтово через volatile
+void secure_wipe(void* buf, size_t len) {
+#if defined(__GNUC__)
+    memset(buf, 0, len);
+    __asm__ __volatile__("" : : "r"(buf) : "memory");
+#else
+    volatile uint8_t *p = (volatile uint8_t *)buf;
+    for (size_t i = 0; i < len; i++) {
+        p[i] = 0;
+    }
+#endif
+}
+
+// Только AES-часть контекста: этого достаточно для encrypt_block и ctr32_xor
+static void aes_key_setup(Aes256GcmContext *ctx, const uint8_t *key) {
+    AesBackend backend = resolve_aes_backend();
+    ctx->aes_impl = backend;
     
-    if (plaintext_len > 0 && (!plaintext || !ciphertext)) {
+    switch (backend) {
+#if AES_HAVE_X86
+    case AES_BACKEND_AESNI:
+    case AES_BACKEND_VAES:
+        aesni_key_expansion(key, ctx->round_keys);
+        break;
+#endif
+    case AES_BACKEND_BITSLICED:
+        bitsliced_key_expansion(key, ctx->round_keys, ctx->bs_round_keys);
+        break;
+    default:
+        key_expansion(key, ctx->round_keys);
+        break;
+    }
+}
+
+Status aes256_gcm_init(Aes256GcmContext* ctx, const uint8_t* key) {
+    if (!ctx || !key) {
         return STATUS_ERROR;
     }
     
-    uint8_t h[16] = {0};
+    // Ключевое расписание и H = E(K, 0^128) считаются один раз на ключ
+    aes_key_setup(ctx, key);
+    
+    // GHASH на PCLMULQDQ, иначе 4-битные таблицы Шупа (256 байт на ключ)
+    GhashBackend ghash_backend = selected_ghash_backend;
+    if (ghash_backend == GHASH_BACKEND_AUTO) {
+        if (ghash_backend_supported(GHASH_BACKEND_VPCLMUL)) {
+            ghash_backend = GHASH_BACKEND_VPCLMUL;
+        } else if (ghash_backend_supported(GHASH_BACKEND_CLMUL)) {
+            ghash_backend = GHASH_BACKEND_CLMUL;
+        } else {
+            ghash_backend = GHASH_BACKEND_SHOUP4;
+        }
+    }
+    ctx->ghash_impl = ghash_backend;
+    
     uint8_t zero_block[16] = {0};
-    aes256_encrypt(zero_block, h, key);
+    encrypt_block(ctx, zero_block, ctx->h);
     
-    uint8_t j0[16];
-    if (12 == 12) {
-        memset(j0, 0, 16);
-        memcpy(j0, iv, 12);
-        j0[15] = 0x01;
-    } else {
-        memset(j0, 0, 16);
-        memcpy(j0, iv, 12);
-        j0[15] = 0x01;
+    // Предвычисления GHASH только для выбранной реализации
+    switch (ghash_backend) {
+#if AES_HAVE_X86
+    case GHASH_BACKEND_CLMUL:
+        clmul_ghash_init(ctx->h, ctx->h_powers);
+        break;
+    case GHASH_BACKEND_VPCLMUL:
+        vpclmul_ghash_init(ctx->h, ctx->h_powers);
+        break;
+#endif
+    case GHASH_BACKEND_SHOUP4:
+        shoup4_init(ctx->h, ctx->ghash_table);
+        break;
+    case GHASH_BACKEND_SHOUP8:
+        shoup8_init(ctx->h, ctx->ghash_table);
+        break;
+    default:
+        break;
     }
     
-    uint8_t counter[16];
+    return STATUS_OK;
+}
+
+// Плитка CTR+GHASH: вход и выход плитки вместе помещаются в L1
+static const size_t GCM_TILE = 16 * 1024;
+
+// Меньше этого данные обрабатываются в вызывающем потоке: fork/join OpenMP
+// стоит микросекунды, дольше самого шифрования коротких сообщений
+static const size_t GCM_PARALLEL_MIN = GHASH_PARALLEL_MIN_BLOCKS * 16;
+
+// Плитки [tile_begin, tile_end) в текущем потоке, y накапливает их GHASH.
+// Плитка меньше GHASH_PARALLEL_MIN_BLOCKS, хеширование внутри потока
+static void gcm_tiles(const Aes256GcmContext *ctx, uint8_t *y, const uint8_t *counter,
+                      const uint8_t *in, uint8_t *out, size_t len,
+                      size_t tile_begin, size_t tile_end, bool decrypt) {
+    for (size_t tile = tile_begin; tile < tile_end; tile++) {
+        size_t start = tile * GCM_TILE;
+        size_t tile_len = (start + GCM_TILE <= len) ? GCM_TILE : len - start;
+        
+        uint8_t tile_counter[16];
+        ctr_add(counter, (uint32_t)(start / 16), tile_counter);
+        if (decrypt) {
+            ghash_update(ctx, y, in + start, tile_len);
+            ctr32_xor(ctx, tile_counter, in + start, out + start, tile_len);
+        } else {
+            ctr32_xor(ctx, tile_counter, in + start, out + start, tile_len);
+            ghash_update(ctx, y, out + start, tile_len);
+        }
+    }
+}
+
+// Один проход по данным: поток шифрует плитку и сразу хеширует её шифртекст,
+// пока он в кэше. Потоки берут непрерывные диапазоны плиток, частичные GHASH
+// объединяются как в ghash_blocks_parallel. Дополнительной памяти не требуется.
+// При расшифровании шифртекст - это вход, он хешируется до CTR (допускает in == out)
+static void gcm_ctr_ghash(const Aes256GcmContext *ctx, uint8_t *x, const uint8_t *counter,
+                          const uint8_t *in, uint8_t *out, size_t len, bool decrypt) {
+    if (len == 0) {
+        return;
+    }
+    
+    size_t num_tiles = (len + GCM_TILE - 1) / GCM_TILE;
+    
+    if (len < GCM_PARALLEL_MIN || omp_get_max_threads() == 1) {
+        gcm_tiles(ctx, x, counter, in, out, len, 0, num_tiles, decrypt);
+        return;
+    }
+    
+    size_t num_blocks = (len + 15) / 16;
+    uint8_t acc[16] = {0};
+    
+    #pragma omp parallel
+    {
+        size_t num_threads = omp_get_num_threads();
+        size_t t = omp_get_thread_num();
+        size_t tile_begin = num_tiles * t / num_threads;
+        size_t tile_end = num_tiles * (t + 1) / num_threads;
+        
+        uint8_t y[16] = {0};
+        if (t == 0) {
+            memcpy(y, x, 16);
+        }
+        
+        gcm_tiles(ctx, y, counter, in, out, len, tile_begin, tile_end, decrypt);
+        
+        // Блоки после диапазона потока: y * H^(num_blocks - end). Нулевой поток
+        // несёт входное x, даже если плиток ему не досталось (потоков больше плиток)
+        size_t block_end = (tile_end * GCM_TILE < len) ? tile_end * GCM_TILE / 16 : num_blocks;
+        if ((tile_begin < tile_end || t == 0) && block_end < num_blocks) {
+            uint8_t hp[16];
+            h_pow(ctx, num_blocks - block_end, hp);
+            gf_mul(ctx, y, hp, y);
+        }
+        
+        #pragma omp critical
+        for (int j = 0; j < 16; j++) {
+            acc[j] ^= y[j];
+        }
+    }
+    
+    memcpy(x, acc, 16);
+}
+
+// Сообщения не длиннее плитки шифруются целиком в вызывающем потоке,
+// без состояния потока и без OpenMP: вход и выход остаются в L1 между CTR и GHASH
+static const size_t GCM_SMALL_MAX = GCM_TILE;
+
+// Длина - параметр встраиваемой функции: в специализациях gcm_small_fixed она
+// становится константой, и разбиение на полные блоки и хвост считается при компиляции
+static inline __attribute__((always_inline))
+void gcm_small_impl(const Aes256GcmContext *ctx, const uint8_t *iv, const uint8_t *aad, size_t aad_len,
+                    const uint8_t *in, uint8_t *out, size_t len, uint8_t *tag, bool decrypt) {
+    uint8_t j0[16], counter[16], e_j0[16];
+    memset(j0, 0, 16);
+    memcpy(j0, iv, 12);
+    j0[15] = 0x01;
     memcpy(counter, j0, 16);
     inc32(counter);
     
-    // Параллельное шифрование блоков в CTR режиме
-    size_t num_blocks = (plaintext_len + 15) / 16;
+    uint8_t x[16] = {0};
+    if (aad_len > 0) {
+        ghash_update(ctx, x, aad, aad_len);
+    }
+    
+    size_t full = len / 16;
+    size_t rest = len % 16;
+    const uint8_t *c = decrypt ? in : out;
+    
+    if (!decrypt) {
+        ctr32_xor(ctx, counter, in, out, len);
+    }
+    
+    ghash_blocks(ctx, x, c, full);
+    if (rest > 0) {
+        uint8_t block[16] = {0};
+        memcpy(block, c + full * 16, rest);
+        ghash_blocks(ctx, x, block, 1);
+    }
+    ghash_lengths(ctx, x, aad_len, len);
+    
+    if (decrypt) {
+        ctr32_xor(ctx, counter, in, out, len);
+    }
     
-    if (num_blocks > 0) {
-        std::vector<uint8_t> keystreams(num_blocks * 16);
+    encrypt_block(ctx, j0, e_j0);
+    for (int i = 0; i < 16; i++) {
+        tag[i] = x[i] ^ e_j0[i];
+    }
+}
+
+template <size_t LEN>
+static void gcm_small_fixed(const Aes256GcmContext *ctx, const uint8_t *iv, const uint8_t *aad, size_t aad_len,
+                            const uint8_t *in, uint8_t *out, uint8_t *tag, bool decrypt) {
+    gcm_small_impl(ctx, iv, aad, aad_len, in, out, LEN, tag, decrypt);
+}
+
+// Типичные размеры пакетов получают отдельные специализации
+static void gcm_small(const Aes256GcmContext *ctx, const uint8_t *iv, const uint8_t *aad, size_t aad_len,
+                      const uint8_t *in, uint8_t *out, size_t len, uint8_t *tag, bool decrypt) {
+    switch (len) {
+    case 64:
+        gcm_small_fixed<64>(ctx, iv, aad, aad_len, in, out, tag, decrypt);
+        break;
+    case 512:
+        gcm_small_fixed<512>(ctx, iv, aad, aad_len, in, out, tag, decrypt);
+        break;
+    case 1500:
+        gcm_small_fixed<1500>(ctx, iv, aad, aad_len, in, out, tag, decrypt);
+        break;
+    default:
+        gcm_small_impl(ctx, iv, aad, aad_len, in, out, len, tag, decrypt);
+        break;
+    }
+}
+
+// Максимальная длина сообщения GCM: 2^39 - 256 бит
+static const uint64_t GCM_MAX_LEN = (1ULL << 36) - 32;
+
+static Status stream_start(Aes256GcmStream* stream, const Aes256GcmContext* ctx, const uint8_t* iv, bool decrypt) {
+    if (!stream || !ctx || !iv) {
+        return STATUS_ERROR;
+    }
+    
+    stream->ctx = ctx;
+    
+    // 96-битный IV: J0 = IV || 0^31 || 1
+    memset(stream->j0, 0, 16);
+    memcpy(stream->j0, iv, 12);
+    stream->j0[15] = 0x01;
+    
+    memcpy(stream->counter, stream->j0, 16);
+    inc32(stream->counter);
+    
+    memset(stream->x, 0, 16);
+    stream->partial_len = 0;
+    stream->aad_len = 0;
+    stream->total_len = 0;
+    stream->decrypt = decrypt;
+    stream->finished = 0;
+    
+    return STATUS_OK;
+}
+
+Status aes256_gcm_stream_init(Aes256GcmStream* stream, const Aes256GcmContext* ctx, const uint8_t* iv) {
+    return stream_start(stream, ctx, iv, false);
+}
+
+Status aes256_gcm_stream_init_decrypt(Aes256GcmStream* stream, const Aes256GcmContext* ctx, const uint8_t* iv) {
+    return stream_start(stream, ctx, iv, true);
+}
+
+Status aes256_gcm_stream_aad(Aes256GcmStream* stream, const uint8_t* aad, size_t aad_len) {
+    if (!stream || (aad_len > 0 && !aad) || stream->finished) {
+        return STATUS_ERROR;
+    }
+    
+    // AAD хешируется целиком до данных, повторный вызов сдвинул бы выравнивание
+    if (stream->aad_len > 0 || stream->total_len > 0) {
+        return STATUS_ERROR;
+    }
+    if (aad_len > GCM_MAX_LEN) {
+        return STATUS_ERROR;
+    }
+    
+    ghash_update(stream->ctx, stream->x, aad, aad_len);
+    stream->aad_len = aad_len;
+    
+    return STATUS_OK;
+}
+
+Status aes256_gcm_stream_update(Aes256GcmStream* stream, const uint8_t* in, uint8_t* out, size_t len) {
+    if (!stream || (len > 0 && (!in || !out)) || !buffers_alias_ok(in, out, len) || stream->finished) {
+        return STATUS_ERROR;
+    }
+    
+    if (len > GCM_MAX_LEN - stream->total_len) {
+        return STATUS_ERROR;
+    }
+    stream->total_len += len;
+    
+    const Aes256GcmContext *ctx = stream->ctx;
+    bool decrypt = stream->decrypt != 0;
+    
+    // Дописываем неполный блок с прошлого вызова остатком его гаммы;
+    // в partial копится шифртекст: выход при шифровании, вход при расшифровании
+    if (stream->partial_len > 0) {
+        size_t n = 16 - stream->partial_len;
+        if (n > len) {
+            n = len;
+        }
+        for (size_t i = 0; i < n; i++) {
+            uint8_t c = in[i];
+            out[i] = c ^ stream->keystream[stream->partial_len + i];
+            stream->partial[stream->partial_len + i] = decrypt ? c : out[i];
+        }
+        stream->partial_len += n;
+        in += n;
+        out += n;
+        len -= n;
         
-        // Генерация keystream параллельно
-        #pragma omp parallel for schedule(static)
-        for (size_t block_idx = 0; block_idx < num_blocks; block_idx++) {
-            uint8_t block_counter[16];
-            memcpy(block_counter, counter, 16);
+        if (stream->partial_len < 16) {
+            return STATUS_OK;
+        }
+        ghash_blocks(ctx, stream->x, stream->partial, 1);
+        stream->partial_len = 0;
+    }
+    
+    // Полные блоки - тем же слитным проходом, что и однократное шифрование
+    size_t full = len & ~(size_t)15;
+    if (full > 0) {
+        gcm_ctr_ghash(ctx, stream->x, stream->counter, in, out, full, decrypt);
+        uint8_t next[16];
+        ctr_add(stream->counter, (uint32_t)(full / 16), next);
+        memcpy(stream->counter, next, 16);
+    }
+    
+    // Хвост: гамма блока сохраняется до следующего вызова
+    size_t rest = len - full;
+    if (rest > 0) {
+        encrypt_block(ctx, stream->counter, stream->keystream);
+        inc32(stream->counter);
+        for (size_t i = 0; i < rest; i++) {
+            uint8_t c = in[full + i];
+            out[full + i] = c ^ stream->keystream[i];
+            stream->partial[i] = decrypt ? c : out[full + i];
+        }
+        stream->partial_len = rest;
+    }
+    
+    return STATUS_OK;
+}
+
+// Блок длин сворачивается в x, поэтому после тега поток закрыт
+static void stream_tag(Aes256GcmStream* stream, uint8_t* tag) {
+    const Aes256GcmContext *ctx = stream->ctx;
+    
+    if (stream->partial_len > 0) {
+        memset(stream->partial + stream->partial_len, 0, 16 - stream->partial_len);
+        ghash_blocks(ctx, stream->x, stream->partial, 1);
+        stream->partial_len = 0;
+    }
+    ghash_lengths(ctx, stream->x, stream->aad_len, stream->total_len);
+    
+    uint8_t e_j0[16];
+    encrypt_block(ctx, stream->j0, e_j0);
+    
+    for (int i = 0; i < 16; i++) {
+        tag[i] = stream->x[i] ^ e_j0[i];
+    }
+    stream->finished = 1;
+}
+
+// Тег расшифровываемого сообщения только сравнивается, через aes256_gcm_stream_verify
+Status aes256_gcm_stream_final(Aes256GcmStream* stream, uint8_t* tag) {
+    if (!stream || !tag || stream->finished || stream->decrypt) {
+        return STATUS_ERROR;
+    }
+    
+    stream_tag(stream, tag);
+    return STATUS_OK;
+}
+
+// Сравнение без раннего выхода: время не зависит от позиции первого различия
+static bool tags_equal(const uint8_t *a, const uint8_t *b) {
+    uint8_t diff = 0;
+    for (int i = 0; i < 16; i++) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+Status aes256_gcm_stream_verify(Aes256GcmStream* stream, const uint8_t* tag) {
+    if (!stream || !tag || stream->finished) {
+        return STATUS_ERROR;
+    }
+    
+    uint8_t computed[16];
+    stream_tag(stream, computed);
+    
+    return tags_equal(computed, tag) ? STATUS_OK : STATUS_ERROR;
+}
+
+Status aes256_gcm_encrypt_aad(const Aes256GcmContext* ctx, const uint8_t* plaintext, uint8_t* ciphertext,
+                              const uint8_t* iv, size_t plaintext_len,
+                              const uint8_t* aad, size_t aad_len, uint8_t* tag) {
+    if (!ctx || !iv || !tag) {
+        return STATUS_ERROR;
+    }
+    
+    if ((plaintext_len > 0 && (!plaintext || !ciphertext)) || (aad_len > 0 && !aad)) {
+        return STATUS_ERROR;
+    }
+    if (!buffers_alias_ok(plaintext, ciphertext, plaintext_len)) {
+        return STATUS_ERROR;
+    }
+    
+    if (plaintext_len <= GCM_SMALL_MAX && aad_len <= GCM_MAX_LEN) {
+        gcm_small(ctx, iv, aad, aad_len, plaintext, ciphertext, plaintext_len, tag, false);
+        return STATUS_OK;
+    }
+    
+    Aes256GcmStream stream;
+    aes256_gcm_stream_init(&stream, ctx, iv);
+    
+    Status status = aes256_gcm_stream_aad(&stream, aad, aad_len);
+    if (status == STATUS_OK) {
+        status = aes256_gcm_stream_update(&stream, plaintext, ciphertext, plaintext_len);
+    }
+    if (status != STATUS_OK) {
+        return status;
+    }
+    
+    return aes256_gcm_stream_final(&stream, tag);
+}
+
+Status aes256_gcm_encrypt(const Aes256GcmContext* ctx, const uint8_t* plaintext, uint8_t* ciphertext,
+                          const uint8_t* iv, size_t plaintext_len, uint8_t* tag) {
+    return aes256_gcm_encrypt_aad(ctx, plaintext, ciphertext, iv, plaintext_len, nullptr, 0, tag);
+}
+
+// Все пути шифрования читают блок до записи на его место: CTR - поблочно
+// в регистрах, GHASH - уже по записанному шифртексту
+Status aes256_gcm_encrypt_inplace(const Aes256GcmContext* ctx, uint8_t* data, const uint8_t* iv, size_t len,
+                                  const uint8_t* aad, size_t aad_len, uint8_t* tag) {
+    return aes256_gcm_encrypt_aad(ctx, data, data, iv, len, aad, aad_len, tag);
+}
+
+Status aes256_gcm_decrypt(const Aes256GcmContext* ctx, const uint8_t* ciphertext, uint8_t* plaintext,
+                          const uint8_t* iv, size_t ciphertext_len,
+                          const uint8_t* aad, size_t aad_len, const uint8_t* tag) {
+    if (!ctx || !iv || !tag) {
+        return STATUS_ERROR;
+    }
+    
+    if ((ciphertext_len > 0 && (!plaintext || !ciphertext)) || (aad_len > 0 && !aad)) {
+        return STATUS_ERROR;
+    }
+    if (!buffers_alias_ok(ciphertext, plaintext, ciphertext_len)) {
+        return STATUS_ERROR;
+    }
+    
+    Status status;
+    if (ciphertext_len <= GCM_SMALL_MAX && aad_len <= GCM_MAX_LEN) {
+        uint8_t computed[16];
+        gcm_small(ctx, iv, aad, aad_len, ciphertext, plaintext, ciphertext_len, computed, true);
+        status = tags_equal(computed, tag) ? STATUS_OK : STATUS_ERROR;
+    } else {
+        // GHASH шифртекста и расшифрование идут одним параллельным проходом
+        Aes256GcmStream stream;
+        aes256_gcm_stream_init_decrypt(&stream, ctx, iv);
+        
+        status = aes256_gcm_stream_aad(&stream, aad, aad_len);
+        if (status == STATUS_OK) {
+            status = aes256_gcm_stream_update(&stream, ciphertext, plaintext, ciphertext_len);
+        }
+        if (status == STATUS_OK) {
+            status = aes256_gcm_stream_verify(&stream, tag);
+        }
+    }
+    
+    // Неаутентифицированный открытый текст не отдаём
+    if (status != STATUS_OK && ciphertext_len > 0) {
+        memset(plaintext, 0, ciphertext_len);
+    }
+    
+    return status;
+}
+
+static bool iov_total(const Aes256GcmIovec *iov, size_t count, uint64_t *total) {
+    if (count > 0 && !iov) {
+        return false;
+    }
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (iov[i].len > 0 && !iov[i].base) {
+            return false;
+        }
+        if (iov[i].len > GCM_MAX_LEN - sum) {
+            return false;
+        }
+        sum += iov[i].len;
+    }
+    *total = sum;
+    return true;
+}
+
+// GHASH по AAD из сегментов: блок, разрезанный границей, собирается в буфере,
+// а выровненная середина сегмента хешируется напрямую (параллельно для больших)
+static void ghash_iov(const Aes256GcmContext *ctx, uint8_t *x, const Aes256GcmIovec *iov, size_t count) {
+    uint8_t block[16];
+    size_t block_len = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t *data = (const uint8_t *)iov[i].base;
+        size_t len = iov[i].len;
+        
+        if (block_len > 0) {
+            size_t n = (16 - block_len < len) ? 16 - block_len : len;
+            memcpy(block + block_len, data, n);
+            block_len += n;
+            data += n;
+            len -= n;
+            if (block_len < 16) {
+                continue;
+            }
+            ghash_blocks(ctx, x, block, 1);
+            block_len = 0;
+        }
+        
+        size_t full = len / 16;
+        ghash_blocks_parallel(ctx, x, data, full);
+        block_len = len % 16;
+        memcpy(block, data + full * 16, block_len);
+    }
+    
+    if (block_len > 0) {
+        memset(block + block_len, 0, 16 - block_len);
+        ghash_blocks(ctx, x, block, 1);
+    }
+}
+
+// Данные идут кусками, на которых не меняется ни входной, ни выходной сегмент;
+// неполные блоки на стыках берёт на себя потоковый API
+static Status gcm_iov(const Aes256GcmContext* ctx, const uint8_t* iv,
+                      const Aes256GcmIovec* aad, size_t aad_count,
+                      const Aes256GcmIovec* in, size_t in_count,
+                      const Aes256GcmIovec* out, size_t out_count, uint8_t* tag, bool decrypt) {
+    uint64_t aad_len, in_len, out_len;
+    if (!ctx || !iv || !tag || !iov_total(aad, aad_count, &aad_len) ||
+        !iov_total(in, in_count, &in_len) || !iov_total(out, out_count, &out_len) || in_len != out_len) {
+        return STATUS_ERROR;
+    }
+    
+    Aes256GcmStream stream;
+    stream_start(&stream, ctx, iv, decrypt);
+    ghash_iov(ctx, stream.x, aad, aad_count);
+    stream.aad_len = aad_len;
+    
+    size_t i = 0, j = 0, in_off = 0, out_off = 0;
+    while (i < in_count && j < out_count) {
+        size_t n = in[i].len - in_off;
+        if (out[j].len - out_off < n) {
+            n = out[j].len - out_off;
+        }
+        if (n > 0) {
+            Status status = aes256_gcm_stream_update(&stream, (const uint8_t *)in[i].base + in_off,
+                                                     (uint8_t *)out[j].base + out_off, n);
+            if (status != STATUS_OK) {
+                return status;
+            }
+        }
+        in_off += n;
+        out_off += n;
+        if (in_off == in[i].len) {
+            i++;
+            in_off = 0;
+        }
+        if (out_off == out[j].len) {
+            j++;
+            out_off = 0;
+        }
+    }
+    
+    stream_tag(&stream, tag);
+    return STATUS_OK;
+}
+
+Status aes256_gcm_encrypt_iov(const Aes256GcmContext* ctx, const uint8_t* iv,
+                              const Aes256GcmIovec* aad, size_t aad_count,
+                              const Aes256GcmIovec* plaintext, size_t plaintext_count,
+                              const Aes256GcmIovec* ciphertext, size_t ciphertext_count, uint8_t* tag) {
+    return gcm_iov(ctx, iv, aad, aad_count, plaintext, plaintext_count, ciphertext, ciphertext_count, tag, false);
+}
+
+Status aes256_gcm_decrypt_iov(const Aes256GcmContext* ctx, const uint8_t* iv,
+                              const Aes256GcmIovec* aad, size_t aad_count,
+                              const Aes256GcmIovec* ciphertext, size_t ciphertext_count,
+                              const Aes256GcmIovec* plaintext, size_t plaintext_count, const uint8_t* tag) {
+    if (!tag) {
+        return STATUS_ERROR;
+    }
+    
+    uint8_t computed[16];
+    Status status = gcm_iov(ctx, iv, aad, aad_count, ciphertext, ciphertext_count, plaintext, plaintext_count,
+                            computed, true);
+    if (status == STATUS_OK && !tags_equal(computed, tag)) {
+        status = STATUS_ERROR;
+    }
+    
+    // Неаутентифицированный открытый текст не отдаём
+    uint64_t total;
+    if (status != STATUS_OK && iov_total(plaintext, plaintext_count, &total)) {
+        for (size_t i = 0; i < plaintext_count; i++) {
+            if (plaintext[i].len > 0) {
+                memset(plaintext[i].base, 0, plaintext[i].len);
+            }
+        }
+    }
+    
+    return status;
+}
+
+// Батч обрабатывается группами подряд идущих сообщений: поток берёт группу целиком,
+// а блоки её коротких сообщений шифруются одним многоключевым проходом
+static const size_t BATCH_GROUP = 8;
+// Длинные сообщения идут обычным путём, конвейер заполняют их собственные блоки
+static const size_t BATCH_SMALL_MAX = 512;
+static const size_t BATCH_MAX_BLOCKS = BATCH_GROUP * (1 + BATCH_SMALL_MAX / 16);
+
+// Сообщение батча целиком в текущем потоке; длинные идут обычным путём
+static void batch_encrypt_one(const Aes256GcmContext *ctx, const Aes256GcmBatchEntry &e) {
+    if (e.len <= GCM_SMALL_MAX) {
+        gcm_small(ctx, e.iv, nullptr, 0, e.plaintext, e.ciphertext, e.len, e.tag, false);
+    } else {
+        aes256_gcm_encrypt(ctx, e.plaintext, e.ciphertext, e.iv, e.len, e.tag);
+    }
+}
+
+static void batch_encrypt_group(const Aes256GcmBatchEntry* entries, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    
+    Aes256GcmContext ctxs[BATCH_GROUP];
+    const Aes256GcmContext *ctx_of[BATCH_GROUP];
+    
+    // Соседние записи с тем же ключом делят контекст
+    size_t num_ctx = 0;
+    for (size_t m = 0; m < count; m++) {
+        if (m > 0 && (entries[m].key == entries[m - 1].key ||
+                      memcmp(entries[m].key, entries[m - 1].key, 32) == 0)) {
+            ctx_of[m] = ctx_of[m - 1];
+        } else {
+            aes256_gcm_init(&ctxs[num_ctx], entries[m].key);
+            ctx_of[m] = &ctxs[num_ctx++];
+        }
+    }
+    
+#if AES_HAVE_X86
+    if (ctxs[0].aes_impl == AES_BACKEND_AESNI || ctxs[0].aes_impl == AES_BACKEND_VAES) {
+        // J0 и счётчики всех коротких сообщений подряд, каждый со своим ключом
+        uint8_t blocks[BATCH_MAX_BLOCKS * 16];
+        const uint8_t *keys[BATCH_MAX_BLOCKS];
+        size_t first[BATCH_GROUP];
+        size_t nblocks = 0;
+        
+        for (size_t m = 0; m < count; m++) {
+            if (entries[m].len > BATCH_SMALL_MAX) {
+                continue;
+            }
+            first[m] = nblocks;
+            
+            const uint8_t *rk = ctx_of[m]->round_keys;
+            size_t n = (entries[m].len + 15) / 16;
             
-            // Инкремент счётчика для этого блока
-            uint32_t val = ((uint32_t)block_counter[12] << 24) |
-                           ((uint32_t)block_counter[13] << 16) |
-                           ((uint32_t)block_counter[14] << 8) |
-                           ((uint32_t)block_counter[15]);
-            val += block_idx;
-            block_counter[12] = (val >> 24) & 0xff;
-            block_counter[13] = (val >> 16) & 0xff;
-            block_counter[14] = (val >> 8) & 0xff;
-            block_counter[15] = val & 0xff;
+            uint8_t *j0 = blocks + nblocks * 16;
+            memset(j0, 0, 16);
+            memcpy(j0, entries[m].iv, 12);
+            j0[15] = 0x01;
+            keys[nblocks++] = rk;
             
-            aes256_encrypt(block_counter, &keystreams[block_idx * 16], key);
+            for (size_t k = 0; k < n; k++) {
+                ctr_add(j0, (uint32_t)(k + 1), blocks + nblocks * 16);
+                keys[nblocks++] = rk;
+            }
         }
         
-        // XOR с plaintext
-        for (size_t i = 0; i < plaintext_len; i++) {
-            ciphertext[i] = plaintext[i] ^ keystreams[i];
+        if (nblocks > 0) {
+            aesni_encrypt_blocks_multi(keys, blocks, blocks, nblocks);
         }
+        
+        for (size_t m = 0; m < count; m++) {
+            const Aes256GcmBatchEntry &e = entries[m];
+            if (e.len > BATCH_SMALL_MAX) {
+                batch_encrypt_one(ctx_of[m], e);
+                continue;
+            }
+            
+            // Первый блок - E(J0), дальше гамма. Поля записи копируются в локальные
+            // переменные: запись через uint8_t* иначе заставляет перечитывать их на каждом байте
+            const uint8_t *ks = blocks + first[m] * 16;
+            const uint8_t *in = e.plaintext;
+            uint8_t *out = e.ciphertext;
+            size_t len = e.len;
+            for (size_t j = 0; j < len; j++) {
+                out[j] = in[j] ^ ks[16 + j];
+            }
+            
+            uint8_t x[16] = {0};
+            ghash_update(ctx_of[m], x, out, len);
+            ghash_lengths(ctx_of[m], x, 0, len);
+            uint8_t *tag = e.tag;
+            for (int i = 0; i < 16; i++) {
+                tag[i] = x[i] ^ ks[i];
+            }
+        }
+        
+        // Гамма и контексты с раундовыми ключами и таблицами H не переживают группу
+        secure_wipe(blocks, nblocks * 16);
+        secure_wipe(ctxs, num_ctx * sizeof(ctxs[0]));
+        return;
     }
+#endif
     
-    ghash(h, nullptr, 0, ciphertext, plaintext_len, tag);
+    for (size_t m = 0; m < count; m++) {
+        batch_encrypt_one(ctx_of[m], entries[m]);
+    }
+    secure_wipe(ctxs, num_ctx * sizeof(ctxs[0]));
+}
+
+Status aes256_gcm_encrypt_batch(const Aes256GcmBatchEntry* entries, size_t count) {
+    if (count > 0 && !entries) {
+        return STATUS_ERROR;
+    }
     
-    uint8_t e_j0[16];
-    aes256_encrypt(j0, e_j0, key);
+    // Проверяем весь батч до начала работы, чтобы не оставлять его частично зашифрованным
+    for (size_t i = 0; i < count; i++) {
+        const Aes256GcmBatchEntry &e = entries[i];
+        if (!e.key || !e.iv || !e.tag || e.len > GCM_MAX_LEN) {
+            return STATUS_ERROR;
+        }
+        if (e.len > 0 && (!e.plaintext || !e.ciphertext)) {
+            return STATUS_ERROR;
+        }
+        if (!buffers_alias_ok(e.plaintext, e.ciphertext, e.len)) {
+            return STATUS_ERROR;
+        }
+    }
     
-    for (int i = 0; i < 16; i++) {
-        tag[i] ^= e_j0[i];
+    size_t num_groups = (count + BATCH_GROUP - 1) / BATCH_GROUP;
+    if (num_groups == 1) {
+        batch_encrypt_group(entries, count);
+        return STATUS_OK;
+    }
+    
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t g = 0; g < num_groups; g++) {
+        size_t start = g * BATCH_GROUP;
+        size_t n = (start + BATCH_GROUP <= count) ? BATCH_GROUP : count - start;
+        batch_encrypt_group(entries + start, n);
     }
     
     return STATUS_OK;
 }
+
+Status aes256_ecb_init(Aes256EcbContext* ctx, const uint8_t* key) {
+    if (!ctx || !key) {
+        return STATUS_ERROR;
+    }
+    
+    AesBackend backend = resolve_aes_backend();
+    ctx->aes_impl = backend;
+    
+    // Оба расписания считаются один раз на ключ; битслайсингу ключи
+    // расшифрования не нужны, он идёт по раундовым ключам в обратном порядке
+    switch (backend) {
+#if AES_HAVE_X86
+    case AES_BACKEND_AESNI:
+    case AES_BACKEND_VAES:
+        aesni_key_expansion(key, ctx->enc_keys);
+        aesni_decrypt_key_expansion(ctx->enc_keys, ctx->dec_keys);
+        break;
+#endif
+    case AES_BACKEND_BITSLICED:
+        bitsliced_key_expansion(key, ctx->enc_keys, ctx->bs_round_keys);
+        break;
+    default:
+        key_expansion(key, ctx->enc_keys);
+        decrypt_key_expansion(ctx->enc_keys, ctx->dec_keys);
+        break;
+    }
+    
+    return STATUS_OK;
+}
+
+static void ecb_blocks(const Aes256EcbContext *ctx, const uint8_t *in, uint8_t *out,
+                       size_t nblocks, bool decrypt) {
+    switch (ctx->aes_impl) {
+#if AES_HAVE_X86
+    case AES_BACKEND_AESNI:
+    case AES_BACKEND_VAES:
+        if (decrypt) {
+            aesni_ecb_decrypt(ctx->dec_keys, in, out, nblocks);
+        } else {
+            aesni_ecb_encrypt(ctx->enc_keys, in, out, nblocks);
+        }
+        break;
+#endif
+    case AES_BACKEND_BITSLICED:
+        if (decrypt) {
+            bitsliced_ecb_decrypt(ctx->bs_round_keys, in, out, nblocks);
+        } else {
+            bitsliced_ecb_encrypt(ctx->bs_round_keys, in, out, nblocks);
+        }
+        break;
+    case AES_BACKEND_TTABLE:
+        if (decrypt) {
+            ttable_ecb_decrypt(ctx->dec_keys, in, out, nblocks);
+        } else {
+            ttable_ecb_encrypt(ctx->enc_keys, in, out, nblocks);
+        }
+        break;
+    default:
+        for (size_t i = 0; i < nblocks; i++) {
+            if (decrypt) {
+                aes256_decrypt_block(in + i * 16, out + i * 16, ctx->enc_keys);
+            } else {
+                aes256_encrypt_block(in + i * 16, out + i * 16, ctx->enc_keys);
+            }
+        }
+        break;
+    }
+}
+
+// Блоки ECB независимы: потоки берут непрерывные диапазоны блоков,
+// порог тот же, что у GCM
+static Status ecb_crypt(const Aes256EcbContext *ctx, const uint8_t *in, uint8_t *out,
+                        size_t len, bool decrypt) {
+    if (!ctx || len % 16 != 0 || (len > 0 && (!in || !out)) || !buffers_alias_ok(in, out, len)) {
+        return STATUS_ERROR;
+    }
+    
+    size_t nblocks = len / 16;
+    if (len < GCM_PARALLEL_MIN || omp_get_max_threads() == 1) {
+        ecb_blocks(ctx, in, out, nblocks, decrypt);
+        return STATUS_OK;
+    }
+    
+    #pragma omp parallel
+    {
+        size_t num_threads = omp_get_num_threads();
+        size_t t = omp_get_thread_num();
+        size_t begin = nblocks * t / num_threads;
+        size_t end = nblocks * (t + 1) / num_threads;
+        ecb_blocks(ctx, in + begin * 16, out + begin * 16, end - begin, decrypt);
+    }
+    
+    return STATUS_OK;
+}
+
+Status aes256_ecb_encrypt(const Aes256EcbContext* ctx, const uint8_t* in, uint8_t* out, size_t len) {
+    return ecb_crypt(ctx, in, out, len, false);
+}
+
+Status aes256_ecb_decrypt(const Aes256EcbContext* ctx, const uint8_t* in, uint8_t* out, size_t len) {
+    return ecb_crypt(ctx, in, out, len, true);
+}
+
+// CTR_DRBG по NIST SP 800-90A на AES-256 без функции выведения, ctr_len = 32:
+// V увеличивается как счётчик GCM (inc32), поэтому гамма - тот же ctr32_xor
+static const size_t DRBG_SEED_LEN = 48;
+// Предел одного запроса Generate: 2^19 бит. Длинный вызов режется на такие запросы
+static const size_t DRBG_MAX_REQUEST = 64 * 1024;
+static const uint64_t DRBG_RESEED_INTERVAL = 1ULL << 48;
+
+// Update: (Key || V) = (E(Key, V+1) || E(Key, V+2) || E(Key, V+3)) ^ data
+static void drbg_update(uint8_t *key, uint8_t *v, const uint8_t *data) {
+    Aes256GcmContext ctx;
+    aes_key_setup(&ctx, key);
+    
+    uint8_t counter[16], temp[DRBG_SEED_LEN];
+    ctr_add(v, 1, counter);
+    memcpy(temp, data, DRBG_SEED_LEN);
+    ctr32_xor(&ctx, counter, temp, temp, DRBG_SEED_LEN);
+    
+    memcpy(key, temp, 32);
+    memcpy(v, temp + 32, 16);
+    
+    secure_wipe(&ctx, sizeof(ctx));
+    secure_wipe(counter, sizeof(counter));
+    secure_wipe(temp, sizeof(temp));
+}
+
+// Короткие строки дополняются нулями до seedlen
+static void drbg_seed_material(const uint8_t *entropy, const uint8_t *data, size_t data_len, uint8_t *out) {
+    for (size_t i = 0; i < DRBG_SEED_LEN; i++) {
+        uint8_t d = (i < data_len) ? data[i] : 0;
+        out[i] = (entropy ? entropy[i] : 0) ^ d;
+    }
+}
+
+Status aes256_ctr_drbg_init(Aes256CtrDrbg* drbg, const uint8_t* entropy,
+                            const uint8_t* personalization, size_t personalization_len) {
+    if (!drbg || !entropy || personalization_len > DRBG_SEED_LEN ||
+        (personalization_len > 0 && !personalization)) {
+        return STATUS_ERROR;
+    }
+    
+    uint8_t seed[DRBG_SEED_LEN];
+    drbg_seed_material(entropy, personalization, personalization_len, seed);
+    
+    memset(drbg->key, 0, 32);
+    memset(drbg->v, 0, 16);
+    drbg_update(drbg->key, drbg->v, seed);
+    drbg->reseed_counter = 1;
+    secure_wipe(seed, sizeof(seed));
+    
+    return STATUS_OK;
+}
+
+Status aes256_ctr_drbg_reseed(Aes256CtrDrbg* drbg, const uint8_t* entropy,
+                              const uint8_t* additional, size_t additional_len) {
+    if (!drbg || !entropy || additional_len > DRBG_SEED_LEN || (additional_len > 0 && !additional)) {
+        return STATUS_ERROR;
+    }
+    
+    uint8_t seed[DRBG_SEED_LEN];
+    drbg_seed_material(entropy, additional, additional_len, seed);
+    drbg_update(drbg->key, drbg->v, seed);
+    drbg->reseed_counter = 1;
+    secure_wipe(seed, sizeof(seed));
+    
+    return STATUS_OK;
+}
+
+// Один запрос Generate с готовыми Key и V: гамма от V+1, выход предварительно обнулён
+static void drbg_fill(const uint8_t *key, const uint8_t *v, uint8_t *out, size_t len) {
+    Aes256GcmContext ctx;
+    aes_key_setup(&ctx, key);
+    
+    uint8_t counter[16];
+    ctr_add(v, 1, counter);
+    memset(out, 0, len);
+    ctr32_xor(&ctx, counter, out, out, len);
+    
+    secure_wipe(&ctx, sizeof(ctx));
+    secure_wipe(counter, sizeof(counter));
+}
+
+// Запросы зависят друг от друга только через (Key, V) после Update, а это
+// три блока AES на 64 КБ. Поэтому цепочка состояний считается последовательно,
+// а сами запросы - непрерывные диапазоны счётчика - раздаются потокам
+Status aes256_ctr_drbg_generate(Aes256CtrDrbg* drbg, uint8_t* out, size_t len,
+                                const uint8_t* additional, size_t additional_len) {
+    if (!drbg || (len > 0 && !out) || additional_len > DRBG_SEED_LEN || (additional_len > 0 && !additional)) {
+        return STATUS_ERROR;
+    }
+    
+    size_t num_requests = (len == 0) ? 1 : (len + DRBG_MAX_REQUEST - 1) / DRBG_MAX_REQUEST;
+    if (drbg->reseed_counter > DRBG_RESEED_INTERVAL - (num_requests - 1)) {
+        return STATUS_ERROR; // нужен reseed
+    }
+    
+    uint8_t add[DRBG_SEED_LEN];
+    drbg_seed_material(nullptr, additional, additional_len, add);
+    if (additional_len > 0) {
+        drbg_update(drbg->key, drbg->v, add);
+    }
+    
+    // Состояние (Key || V) перед каждым запросом; дополнительный вход относится
+    // только к первому, остальные - как вызовы Generate без него
+    std::vector<uint8_t> states(num_requests * DRBG_SEED_LEN);
+    uint8_t zeros[DRBG_SEED_LEN] = {0};
+    for (size_t r = 0; r < num_requests; r++) {
+        memcpy(&states[r * DRBG_SEED_LEN], drbg->key, 32);
+        memcpy(&states[r * DRBG_SEED_LEN + 32], drbg->v, 16);
+        
+        size_t start = r * DRBG_MAX_REQUEST;
+        size_t n = (start + DRBG_MAX_REQUEST <= len) ? DRBG_MAX_REQUEST : len - start;
+        uint8_t v_end[16];
+        ctr_add(drbg->v, (uint32_t)((n + 15) / 16), v_end);
+        memcpy(drbg->v, v_end, 16);
+        secure_wipe(v_end, sizeof(v_end));
+        drbg_update(drbg->key, drbg->v, r == 0 ? add : zeros);
+    }
+    drbg->reseed_counter += num_requests;
+    
+    if (len < GCM_PARALLEL_MIN || omp_get_max_threads() == 1) {
+        for (size_t r = 0; r < num_requests && len > 0; r++) {
+            size_t start = r * DRBG_MAX_REQUEST;
+            size_t n = (start + DRBG_MAX_REQUEST <= len) ? DRBG_MAX_REQUEST : len - start;
+            drbg_fill(&states[r * DRBG_SEED_LEN], &states[r * DRBG_SEED_LEN + 32], out + start, n);
+        }
+    } else {
+        #pragma omp parallel for schedule(static)
+        for (size_t r = 0; r < num_requests; r++) {
+            size_t start = r * DRBG_MAX_REQUEST;
+            size_t n = (start + DRBG_MAX_REQUEST <= len) ? DRBG_MAX_REQUEST : len - start;
+            drbg_fill(&states[r * DRBG_SEED_LEN], &states[r * DRBG_SEED_LEN + 32], out + start, n);
+        }
+    }
+    
+    // Ключи запросов больше не нужны
+    secure_wipe(states.data(), states.size());
+    secure_wipe(add, sizeof(add));
+    
+    return STATUS_OK;
+}
+
+Status aes256_gcm(const uint8_t* plaintext, uint8_t* ciphertext,
+                  const uint8_t* key, const uint8_t* iv, size_t plaintext_len, uint8_t* tag) {
+    if (!key || !iv || !tag) {
+        return STATUS_ERROR;
+    }
+    
+    Aes256GcmContext ctx;
+    aes256_gcm_init(&ctx, key);
+    
+    return aes256_gcm_encrypt(&ctx, plaintext, ciphertext, iv, plaintext_len, tag);
+}
@@ -0,0 +1,536 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "aes_impl.hpp"
+
+// Битслайсинговая реализация AES-256 без обращений к таблицам по секретным индексам
+// (схема "ct64": S-box Бойяра-Перальты на логических операциях).
+// Слово W хранит одну битовую плоскость: uint64_t - 4 блока, u64x2 - 8 блоков,
+// операции над u64x2 компилятор раскладывает в SSE2/NEON.
+
+typedef uint64_t u64x2 __attribute__((vector_size(16)));
+
+template <typename W>
+static inline void bitslice_sbox(W *q) {
+    W x0, x1, x2, x3, x4, x5, x6, x7;
+    W y1, y2, y3, y4, y5, y6, y7, y8, y9;
+    W y10, y11, y12, y13, y14, y15, y16, y17, y18, y19;
+    W y20, y21;
+    W z0, z1, z2, z3, z4, z5, z6, z7, z8, z9;
+    W z10, z11, z12, z13, z14, z15, z16, z17;
+    W t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+    W t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+    W t20, t21, t22, t23, t24, t25, t26, t27, t28, t29;
+    W t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+    W t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+    W t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+    W t60, t61, t62, t63, t64, t65, t66, t67;
+    W s0, s1, s2, s3, s4, s5, s6, s7;
+
+    x0 = q[7];
+    x1 = q[6];
+    x2 = q[5];
+    x3 = q[4];
+    x4 = q[3];
+    x5 = q[2];
+    x6 = q[1];
+    x7 = q[0];
+
+    // Верхнее линейное преобразование
+    y14 = x3 ^ x5;
+    y13 = x0 ^ x6;
+    y9 = x0 ^ x3;
+    y8 = x0 ^ x5;
+    t0 = x1 ^ x2;
+    y1 = t0 ^ x7;
+    y4 = y1 ^ x3;
+    y12 = y13 ^ y14;
+    y2 = y1 ^ x0;
+    y5 = y1 ^ x6;
+    y3 = y5 ^ y8;
+    t1 = x4 ^ y12;
+    y15 = t1 ^ x5;
+    y20 = t1 ^ x1;
+    y6 = y15 ^ x7;
+    y10 = y15 ^ t0;
+    y11 = y20 ^ y9;
+    y7 = x7 ^ y11;
+    y17 = y10 ^ y11;
+    y19 = y10 ^ y8;
+    y16 = t0 ^ y11;
+    y21 = y13 ^ y16;
+    y18 = x0 ^ y16;
+
+    // Нелинейная часть (инверсия в GF(2^8))
+    t2 = y12 & y15;
+    t3 = y3 & y6;
+    t4 = t3 ^ t2;
+    t5 = y4 & x7;
+    t6 = t5 ^ t2;
+    t7 = y13 & y16;
+    t8 = y5 & y1;
+    t9 = t8 ^ t7;
+    t10 = y2 & y7;
+    t11 = t10 ^ t7;
+    t12 = y9 & y11;
+    t13 = y14 & y17;
+    t14 = t13 ^ t12;
+    t15 = y8 & y10;
+    t16 = t15 ^ t12;
+    t17 = t4 ^ t14;
+    t18 = t6 ^ t16;
+    t19 = t9 ^ t14;
+    t20 = t11 ^ t16;
+    t21 = t17 ^ y20;
+    t22 = t18 ^ y19;
+    t23 = t19 ^ y21;
+    t24 = t20 ^ y18;
+
+    t25 = t21 ^ t22;
+    t26 = t21 & t23;
+    t27 = t24 ^ t26;
+    t28 = t25 & t27;
+    t29 = t28 ^ t22;
+    t30 = t23 ^ t24;
+    t31 = t22 ^ t26;
+    t32 = t31 & t30;
+    t33 = t32 ^ t24;
+    t34 = t23 ^ t33;
+    t35 = t27 ^ t33;
+    t36 = t24 & t35;
+    t37 = t36 ^ t34;
+    t38 = t27 ^ t36;
+    t39 = t29 & t38;
+    t40 = t25 ^ t39;
+
+    t41 = t40 ^ t37;
+    t42 = t29 ^ t33;
+    t43 = t29 ^ t40;
+    t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;
+    z1 = t37 & y6;
+    z2 = t33 & x7;
+    z3 = t43 & y16;
+    z4 = t40 & y1;
+    z5 = t29 & y7;
+    z6 = t42 & y11;
+    z7 = t45 & y17;
+    z8 = t41 & y10;
+    z9 = t44 & y12;
+    z10 = t37 & y3;
+    z11 = t33 & y4;
+    z12 = t43 & y13;
+    z13 = t40 & y5;
+    z14 = t29 & y2;
+    z15 = t42 & y9;
+    z16 = t45 & y14;
+    z17 = t41 & y8;
+
+    // Нижнее линейное преобразование
+    t46 = z15 ^ z16;
+    t47 = z10 ^ z11;
+    t48 = z5 ^ z13;
+    t49 = z9 ^ z10;
+    t50 = z2 ^ z12;
+    t51 = z2 ^ z5;
+    t52 = z7 ^ z8;
+    t53 = z0 ^ z3;
+    t54 = z6 ^ z7;
+    t55 = z16 ^ z17;
+    t56 = z12 ^ t48;
+    t57 = t50 ^ t53;
+    t58 = z4 ^ t46;
+    t59 = z3 ^ t54;
+    t60 = t46 ^ t57;
+    t61 = z14 ^ t57;
+    t62 = t52 ^ t58;
+    t63 = t49 ^ t58;
+    t64 = z4 ^ t59;
+    t65 = t61 ^ t62;
+    t66 = z1 ^ t63;
+    s0 = t59 ^ t63;
+    s6 = t56 ^ ~t62;
+    s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65;
+    s3 = t53 ^ t66;
+    s4 = t51 ^ t66;
+    s5 = t47 ^ t65;
+    s1 = t64 ^ ~s3;
+    s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+template <typename W>
+static inline void swap_n(W &x, W &y, uint64_t cl, uint64_t ch, int s) {
+    W a = x, b = y;
+    x = (a & cl) | ((b & cl) << s);
+    y = ((a & ch) >> s) | (b & ch);
+}
+
+// Транспонирование 8x8 бит: переход между побайтовым и битслайсинговым представлением
+template <typename W>
+static inline void ortho(W *q) {
+    swap_n(q[0], q[1], 0x5555555555555555ULL, 0xAAAAAAAAAAAAAAAAULL, 1);
+    swap_n(q[2], q[3], 0x5555555555555555ULL, 0xAAAAAAAAAAAAAAAAULL, 1);
+    swap_n(q[4], q[5], 0x5555555555555555ULL, 0xAAAAAAAAAAAAAAAAULL, 1);
+    swap_n(q[6], q[7], 0x5555555555555555ULL, 0xAAAAAAAAAAAAAAAAULL, 1);
+
+    swap_n(q[0], q[2], 0x3333333333333333ULL, 0xCCCCCCCCCCCCCCCCULL, 2);
+    swap_n(q[1], q[3], 0x3333333333333333ULL, 0xCCCCCCCCCCCCCCCCULL, 2);
+    swap_n(q[4], q[6], 0x3333333333333333ULL, 0xCCCCCCCCCCCCCCCCULL, 2);
+    swap_n(q[5], q[7], 0x3333333333333333ULL, 0xCCCCCCCCCCCCCCCCULL, 2);
+
+    swap_n(q[0], q[4], 0x0F0F0F0F0F0F0F0FULL, 0xF0F0F0F0F0F0F0F0ULL, 4);
+    swap_n(q[1], q[5], 0x0F0F0F0F0F0F0F0FULL, 0xF0F0F0F0F0F0F0F0ULL, 4);
+    swap_n(q[2], q[6], 0x0F0F0F0F0F0F0F0FULL, 0xF0F0F0F0F0F0F0F0ULL, 4);
+    swap_n(q[3], q[7], 0x0F0F0F0F0F0F0F0FULL, 0xF0F0F0F0F0F0F0F0ULL, 4);
+}
+
+template <typename W>
+static inline void shift_rows(W *q) {
+    for (int i = 0; i < 8; i++) {
+        W x = q[i];
+        q[i] = (x & 0x000000000000FFFFULL)
+            | ((x & 0x00000000FFF00000ULL) >> 4)
+            | ((x & 0x00000000000F0000ULL) << 12)
+            | ((x & 0x0000FF0000000000ULL) >> 8)
+            | ((x & 0x000000FF00000000ULL) << 8)
+            | ((x & 0xF000000000000000ULL) >> 12)
+            | ((x & 0x0FFF000000000000ULL) << 4);
+    }
+}
+
+template <typename W>
+static inline W rotr32(W x) {
+    return (x << 32) | (x >> 32);
+}
+
+template <typename W>
+static inline void mix_columns(W *q) {
+    W q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    W q4 = q[4], q5 = q[5], q6 = q[6], q7 = q[7];
+    W r0 = (q0 >> 16) | (q0 << 48);
+    W r1 = (q1 >> 16) | (q1 << 48);
+    W r2 = (q2 >> 16) | (q2 << 48);
+    W r3 = (q3 >> 16) | (q3 << 48);
+    W r4 = (q4 >> 16) | (q4 << 48);
+    W r5 = (q5 >> 16) | (q5 << 48);
+    W r6 = (q6 >> 16) | (q6 << 48);
+    W r7 = (q7 >> 16) | (q7 << 48);
+
+    q[0] = q7 ^ r7 ^ r0 ^ rotr32(q0 ^ r0);
+    q[1] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ rotr32(q1 ^ r1);
+    q[2] = q1 ^ r1 ^ r2 ^ rotr32(q2 ^ r2);
+    q[3] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ rotr32(q3 ^ r3);
+    q[4] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ rotr32(q4 ^ r4);
+    q[5] = q4 ^ r4 ^ r5 ^ rotr32(q5 ^ r5);
+    q[6] = q5 ^ r5 ^ r6 ^ rotr32(q6 ^ r6);
+    q[7] = q6 ^ r6 ^ r7 ^ rotr32(q7 ^ r7);
+}
+
+// Обратный S-box через прямую схему: InvSbox = L o Sbox o L, где L(y) = A^-1(y ^ 0x63)
+// и A - аффинное преобразование S-box. Плоскость q[i] - бит i каждого байта
+template <typename W>
+static inline void inv_affine(W *q) {
+    W q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    W q4 = q[4], q5 = q[5], q6 = q[6], q7 = q[7];
+    q[0] = ~(q2 ^ q5 ^ q7);
+    q[1] = q3 ^ q6 ^ q0;
+    q[2] = ~(q4 ^ q7 ^ q1);
+    q[3] = q5 ^ q0 ^ q2;
+    q[4] = q6 ^ q1 ^ q3;
+    q[5] = q7 ^ q2 ^ q4;
+    q[6] = q0 ^ q3 ^ q5;
+    q[7] = q1 ^ q4 ^ q6;
+}
+
+template <typename W>
+static inline void inv_bitslice_sbox(W *q) {
+    inv_affine(q);
+    bitslice_sbox(q);
+    inv_affine(q);
+}
+
+template <typename W>
+static inline void inv_shift_rows(W *q) {
+    for (int i = 0; i < 8; i++) {
+        W x = q[i];
+        q[i] = (x & 0x000000000000FFFFULL)
+            | ((x & 0x000000000FFF0000ULL) << 4)
+            | ((x & 0x00000000F0000000ULL) >> 12)
+            | ((x & 0x0000FF0000000000ULL) >> 8)
+            | ((x & 0x000000FF00000000ULL) << 8)
+            | ((x & 0x000F000000000000ULL) << 12)
+            | ((x & 0xFFF0000000000000ULL) >> 4);
+    }
+}
+
+// InvMixColumns = MixColumns o [05 00 04 00]: сначала a_i ^= 04 * (a_i ^ a_(i+2)),
+// строка i+2 столбца - это rotr32, умножение на 04 - два xtime по битовым плоскостям
+template <typename W>
+static inline void inv_mix_columns(W *q) {
+    W t[8];
+    for (int i = 0; i < 8; i++) {
+        t[i] = q[i] ^ rotr32(q[i]);
+    }
+    for (int k = 0; k < 2; k++) {
+        W hi = t[7];
+        t[7] = t[6];
+        t[6] = t[5];
+        t[5] = t[4];
+        t[4] = t[3] ^ hi;
+        t[3] = t[2] ^ hi;
+        t[2] = t[1];
+        t[1] = t[0] ^ hi;
+        t[0] = hi;
+    }
+    for (int i = 0; i < 8; i++) {
+        q[i] ^= t[i];
+    }
+    mix_columns(q);
+}
+
+static inline uint32_t load_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void store_le32(uint8_t *p, uint32_t v) {
+    p[0] = v & 0xff;
+    p[1] = (v >> 8) & 0xff;
+    p[2] = (v >> 16) & 0xff;
+    p[3] = (v >> 24) & 0xff;
+}
+
+// Раскладка 16-байтового блока в два 64-битных слова (до ortho)
+static inline void interleave_in(uint64_t *q0, uint64_t *q1, const uint8_t *block) {
+    uint64_t x0 = load_le32(block);
+    uint64_t x1 = load_le32(block + 4);
+    uint64_t x2 = load_le32(block + 8);
+    uint64_t x3 = load_le32(block + 12);
+    x0 |= (x0 << 16);
+    x1 |= (x1 << 16);
+    x2 |= (x2 << 16);
+    x3 |= (x3 << 16);
+    x0 &= 0x0000FFFF0000FFFFULL;
+    x1 &= 0x0000FFFF0000FFFFULL;
+    x2 &= 0x0000FFFF0000FFFFULL;
+    x3 &= 0x0000FFFF0000FFFFULL;
+    x0 |= (x0 << 8);
+    x1 |= (x1 << 8);
+    x2 |= (x2 << 8);
+    x3 |= (x3 << 8);
+    x0 &= 0x00FF00FF00FF00FFULL;
+    x1 &= 0x00FF00FF00FF00FFULL;
+    x2 &= 0x00FF00FF00FF00FFULL;
+    x3 &= 0x00FF00FF00FF00FFULL;
+    *q0 = x0 | (x2 << 8);
+    *q1 = x1 | (x3 << 8);
+}
+
+static inline void interleave_out(uint8_t *block, uint64_t q0, uint64_t q1) {
+    uint64_t x0 = q0 & 0x00FF00FF00FF00FFULL;
+    uint64_t x1 = q1 & 0x00FF00FF00FF00FFULL;
+    uint64_t x2 = (q0 >> 8) & 0x00FF00FF00FF00FFULL;
+    uint64_t x3 = (q1 >> 8) & 0x00FF00FF00FF00FFULL;
+    x0 |= (x0 >> 8);
+    x1 |= (x1 >> 8);
+    x2 |= (x2 >> 8);
+    x3 |= (x3 >> 8);
+    x0 &= 0x0000FFFF0000FFFFULL;
+    x1 &= 0x0000FFFF0000FFFFULL;
+    x2 &= 0x0000FFFF0000FFFFULL;
+    x3 &= 0x0000FFFF0000FFFFULL;
+    store_le32(block, (uint32_t)x0 | (uint32_t)(x0 >> 16));
+    store_le32(block + 4, (uint32_t)x1 | (uint32_t)(x1 >> 16));
+    store_le32(block + 8, (uint32_t)x2 | (uint32_t)(x2 >> 16));
+    store_le32(block + 12, (uint32_t)x3 | (uint32_t)(x3 >> 16));
+}
+
+// SubWord через тот же битслайсинговый S-box, чтобы и расписание ключа было без таблиц
+static uint32_t sub_word(uint32_t x) {
+    uint64_t q[8];
+    memset(q, 0, sizeof(q));
+    q[0] = x;
+    ortho(q);
+    bitslice_sbox(q);
+    ortho(q);
+    return (uint32_t)q[0];
+}
+
+void bitsliced_key_expansion(const uint8_t *key, uint8_t *w, uint64_t *sk) {
+    static const uint32_t rcon[7] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40};
+    uint32_t words[60];
+
+    for (int i = 0; i < 8; i++) {
+        words[i] = load_le32(key + i * 4);
+    }
+
+    uint32_t tmp = words[7];
+    for (int i = 8; i < 60; i++) {
+        if (i % 8 == 0) {
+            tmp = (tmp << 24) | (tmp >> 8);
+            tmp = sub_word(tmp) ^ rcon[i / 8 - 1];
+        } else if (i % 8 == 4) {
+            tmp = sub_word(tmp);
+        }
+        tmp ^= words[i - 8];
+        words[i] = tmp;
+    }
+
+    for (int i = 0; i < 60; i++) {
+        store_le32(w + i * 4, words[i]);
+    }
+
+    // Каждый раундовый ключ размножается на 4 блока и переводится в битовые плоскости
+    for (int r = 0; r < 15; r++) {
+        uint64_t q[8];
+        interleave_in(&q[0], &q[4], w + r * 16);
+        q[1] = q[2] = q[3] = q[0];
+        q[5] = q[6] = q[7] = q[4];
+        ortho(q);
+        memcpy(sk + r * 8, q, sizeof(q));
+    }
+}
+
+static inline void add_round_key(u64x2 *q, const uint64_t *sk) {
+    for (int i = 0; i < 8; i++) {
+        q[i] ^= sk[i];
+    }
+}
+
+// Шифрование 8 блоков: блоки 0-3 в нижней половине слов, 4-7 в верхней
+static void encrypt8(const uint64_t *sk, const uint8_t *in, uint8_t *out) {
+    u64x2 q[8];
+
+    for (int i = 0; i < 4; i++) {
+        uint64_t a0, a1, b0, b1;
+        interleave_in(&a0, &a1, in + i * 16);
+        interleave_in(&b0, &b1, in + (i + 4) * 16);
+        q[i] = (u64x2){a0, b0};
+        q[i + 4] = (u64x2){a1, b1};
+    }
+    ortho(q);
+
+    add_round_key(q, sk);
+    for (int round = 1; round < 14; round++) {
+        bitslice_sbox(q);
+        shift_rows(q);
+        mix_columns(q);
+        add_round_key(q, sk + round * 8);
+    }
+    bitslice_sbox(q);
+    shift_rows(q);
+    add_round_key(q, sk + 14 * 8);
+
+    ortho(q);
+    for (int i = 0; i < 4; i++) {
+        interleave_out(out + i * 16, q[i][0], q[i + 4][0]);
+        interleave_out(out + (i + 4) * 16, q[i][1], q[i + 4][1]);
+    }
+}
+
+// Расшифрование 8 блоков обратным шифром на тех же раундовых ключах
+static void decrypt8(const uint64_t *sk, const uint8_t *in, uint8_t *out) {
+    u64x2 q[8];
+
+    for (int i = 0; i < 4; i++) {
+        uint64_t a0, a1, b0, b1;
+        interleave_in(&a0, &a1, in + i * 16);
+        interleave_in(&b0, &b1, in + (i + 4) * 16);
+        q[i] = (u64x2){a0, b0};
+        q[i + 4] = (u64x2){a1, b1};
+    }
+    ortho(q);
+
+    add_round_key(q, sk + 14 * 8);
+    for (int round = 13; round > 0; round--) {
+        inv_shift_rows(q);
+        inv_bitslice_sbox(q);
+        add_round_key(q, sk + round * 8);
+        inv_mix_columns(q);
+    }
+    inv_shift_rows(q);
+    inv_bitslice_sbox(q);
+    add_round_key(q, sk);
+
+    ortho(q);
+    for (int i = 0; i < 4; i++) {
+        interleave_out(out + i * 16, q[i][0], q[i + 4][0]);
+        interleave_out(out + (i + 4) * 16, q[i][1], q[i + 4][1]);
+    }
+}
+
+void bitsliced_encrypt_block(const uint64_t *sk, const uint8_t *in, uint8_t *out) {
+    uint8_t blocks[128] = {0};
+    memcpy(blocks, in, 16);
+    encrypt8(sk, blocks, blocks);
+    memcpy(out, blocks, 16);
+}
+
+void bitsliced_ctr32(const uint64_t *sk, const uint8_t *counter, const uint8_t *in, uint8_t *out, size_t len) {
+    uint8_t ctr[128], ks[128];
+    uint32_t val = ((uint32_t)counter[12] << 24) |
+                   ((uint32_t)counter[13] << 16) |
+                   ((uint32_t)counter[14] << 8) |
+                   ((uint32_t)counter[15]);
+
+    for (int i = 0; i < 8; i++) {
+        memcpy(ctr + i * 16, counter, 12);
+    }
+
+    while (len > 0) {
+        for (int i = 0; i < 8; i++) {
+            uint32_t v = val + i;
+            ctr[i * 16 + 12] = (v >> 24) & 0xff;
+            ctr[i * 16 + 13] = (v >> 16) & 0xff;
+            ctr[i * 16 + 14] = (v >> 8) & 0xff;
+            ctr[i * 16 + 15] = v & 0xff;
+        }
+        val += 8;
+
+        encrypt8(sk, ctr, ks);
+
+        size_t n = (len < 128) ? len : 128;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = in[i] ^ ks[i];
+        }
+        in += n;
+        out += n;
+        len -= n;
+    }
+}
+
+// Хвост меньше 8 блоков проходит через буфер, лишние слоты шифруют нули
+template <void (*Kernel)(const uint64_t *, const uint8_t *, uint8_t *)>
+static void ecb8(const uint64_t *sk, const uint8_t *in, uint8_t *out, size_t nblocks) {
+    while (nblocks >= 8) {
+        Kernel(sk, in, out);
+        in += 128;
+        out += 128;
+        nblocks -= 8;
+    }
+    if (nblocks > 0) {
+        uint8_t buf[128] = {0};
+        memcpy(buf, in, nblocks * 16);
+        Kernel(sk, buf, buf);
+        memcpy(out, buf, nblocks * 16);
+    }
+}
+
+void bitsliced_ecb_encrypt(const uint64_t *sk, const uint8_t *in, uint8_t *out, size_t nblocks) {
+    ecb8<encrypt8>(sk, in, out, nblocks);
+}
+
+void bitsliced_ecb_decrypt(const uint64_t *sk, const uint8_t *in, uint8_t *out, size_t nblocks) {
+    ecb8<decrypt8>(sk, in, out, nblocks);
+}
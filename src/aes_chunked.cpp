@@ -0,0 +1,218 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <omp.h>
+
+#include "solution.hpp"
+
+// Сегментированный контейнер поверх AES-256-GCM (схема STREAM): каждый чанк -
+// отдельное сообщение GCM со своим nonce и тегом, заголовок - AAD каждого чанка.
+// Записи фиксированного размера, поэтому индекс - это арифметика смещений.
+
+static const uint8_t CHUNKED_MAGIC[4] = {'G', 'C', 'M', '1'};
+static const size_t CHUNKED_TAG_LEN = 16;
+// Номер чанка занимает 32 бита nonce
+static const uint64_t CHUNKED_MAX_CHUNKS = 1ULL << 32;
+// Чанки раздаются потокам только для больших объёмов, как и в aes256_gcm
+static const size_t CHUNKED_PARALLEL_MIN = 64 * 1024;
+
+// prefix (7) || index (4, big-endian) || флаг последнего чанка (1)
+static void chunk_nonce(const Aes256GcmChunked *c, uint64_t index, int last, uint8_t *nonce) {
+    memcpy(nonce, c->header + 8, 7);
+    nonce[7] = (uint8_t)(index >> 24);
+    nonce[8] = (uint8_t)(index >> 16);
+    nonce[9] = (uint8_t)(index >> 8);
+    nonce[10] = (uint8_t)index;
+    nonce[11] = last ? 1 : 0;
+}
+
+static size_t chunk_count(uint32_t chunk_size, size_t len) {
+    return (len == 0) ? 1 : (len + chunk_size - 1) / chunk_size;
+}
+
+// Число записей и длина последней по длине контейнера; false, если она не сходится
+static bool container_layout(const Aes256GcmChunked *c, size_t container_len, size_t *num_chunks, size_t *last_len) {
+    if (container_len < AES256_GCM_CHUNKED_HEADER_LEN + CHUNKED_TAG_LEN) {
+        return false;
+    }
+    size_t body = container_len - AES256_GCM_CHUNKED_HEADER_LEN;
+    size_t record = (size_t)c->chunk_size + CHUNKED_TAG_LEN;
+    size_t n = (body + record - 1) / record;
+    size_t tail = body - (n - 1) * record;
+    if (tail < CHUNKED_TAG_LEN || n > CHUNKED_MAX_CHUNKS) {
+        return false;
+    }
+    *num_chunks = n;
+    *last_len = tail;
+    return true;
+}
+
+Status aes256_gcm_chunked_writer_init(Aes256GcmChunked* c, const Aes256GcmContext* ctx,
+                                      const uint8_t* nonce_prefix, uint32_t chunk_size, uint8_t* header) {
+    if (!c || !ctx || !nonce_prefix || !header || chunk_size == 0) {
+        return STATUS_ERROR;
+    }
+
+    c->ctx = ctx;
+    c->chunk_size = chunk_size;
+    memcpy(c->header, CHUNKED_MAGIC, 4);
+    for (int i = 0; i < 4; i++) {
+        c->header[4 + i] = (uint8_t)(chunk_size >> (8 * i));
+    }
+    memcpy(c->header + 8, nonce_prefix, 7);
+    c->header[15] = 0;
+
+    memcpy(header, c->header, AES256_GCM_CHUNKED_HEADER_LEN);
+    return STATUS_OK;
+}
+
+Status aes256_gcm_chunked_reader_init(Aes256GcmChunked* c, const Aes256GcmContext* ctx, const uint8_t* header) {
+    if (!c || !ctx || !header) {
+        return STATUS_ERROR;
+    }
+    if (memcmp(header, CHUNKED_MAGIC, 4) != 0 || header[15] != 0) {
+        return STATUS_ERROR;
+    }
+
+    uint32_t chunk_size = 0;
+    for (int i = 0; i < 4; i++) {
+        chunk_size |= (uint32_t)header[4 + i] << (8 * i);
+    }
+    if (chunk_size == 0) {
+        return STATUS_ERROR;
+    }
+
+    c->ctx = ctx;
+    c->chunk_size = chunk_size;
+    memcpy(c->header, header, AES256_GCM_CHUNKED_HEADER_LEN);
+    return STATUS_OK;
+}
+
+size_t aes256_gcm_chunked_size(const Aes256GcmChunked* c, size_t plaintext_len) {
+    if (!c || c->chunk_size == 0) {
+        return 0;
+    }
+    return AES256_GCM_CHUNKED_HEADER_LEN + plaintext_len + chunk_count(c->chunk_size, plaintext_len) * CHUNKED_TAG_LEN;
+}
+
+Status aes256_gcm_chunked_write(const Aes256GcmChunked* c, uint64_t index, int last,
+                                const uint8_t* in, size_t len, uint8_t* record) {
+    if (!c || !record || (len > 0 && !in) || index >= CHUNKED_MAX_CHUNKS) {
+        return STATUS_ERROR;
+    }
+    // Неполным может быть только последний чанк
+    if (len > c->chunk_size || (!last && len != c->chunk_size)) {
+        return STATUS_ERROR;
+    }
+
+    uint8_t nonce[12];
+    chunk_nonce(c, index, last, nonce);
+    return aes256_gcm_encrypt_aad(c->ctx, in, record, nonce, len, c->header, AES256_GCM_CHUNKED_HEADER_LEN,
+                                  record + len);
+}
+
+Status aes256_gcm_chunked_read(const Aes256GcmChunked* c, uint64_t index, int last,
+                               const uint8_t* record, size_t record_len, uint8_t* out) {
+    if (!c || !record || index >= CHUNKED_MAX_CHUNKS) {
+        return STATUS_ERROR;
+    }
+    if (record_len < CHUNKED_TAG_LEN || record_len > (size_t)c->chunk_size + CHUNKED_TAG_LEN) {
+        return STATUS_ERROR;
+    }
+    size_t len = record_len - CHUNKED_TAG_LEN;
+    if ((len > 0 && !out) || (!last && len != c->chunk_size)) {
+        return STATUS_ERROR;
+    }
+
+    uint8_t nonce[12];
+    chunk_nonce(c, index, last, nonce);
+    return aes256_gcm_decrypt(c->ctx, record, out, nonce, len, c->header, AES256_GCM_CHUNKED_HEADER_LEN,
+                              record + len);
+}
+
+Status aes256_gcm_chunked_encrypt(const Aes256GcmChunked* c, const uint8_t* plaintext, size_t len,
+                                  uint8_t* container) {
+    if (!c || !container || (len > 0 && !plaintext)) {
+        return STATUS_ERROR;
+    }
+    size_t n = chunk_count(c->chunk_size, len);
+    if (n > CHUNKED_MAX_CHUNKS) {
+        return STATUS_ERROR;
+    }
+
+    memcpy(container, c->header, AES256_GCM_CHUNKED_HEADER_LEN);
+    uint8_t *records = container + AES256_GCM_CHUNKED_HEADER_LEN;
+    size_t record = (size_t)c->chunk_size + CHUNKED_TAG_LEN;
+
+    // Один чанк распараллеливает сам aes256_gcm; несколько - раздаются потокам целиком
+    int failed = 0;
+    bool parallel = n > 1 && len >= CHUNKED_PARALLEL_MIN && omp_get_max_threads() > 1;
+    #pragma omp parallel for schedule(static) reduction(|:failed) if(parallel)
+    for (size_t i = 0; i < n; i++) {
+        size_t start = i * c->chunk_size;
+        size_t chunk_len = (len - start < c->chunk_size) ? len - start : c->chunk_size;
+        if (aes256_gcm_chunked_write(c, i, i == n - 1, plaintext + start, chunk_len, records + i * record) != STATUS_OK) {
+            failed = 1;
+        }
+    }
+
+    return failed ? STATUS_ERROR : STATUS_OK;
+}
+
+Status aes256_gcm_chunked_decrypt(const Aes256GcmContext* ctx, const uint8_t* container, size_t container_len,
+                                  uint8_t* plaintext, size_t* plaintext_len) {
+    if (!ctx || !container || !plaintext || !plaintext_len || container_len < AES256_GCM_CHUNKED_HEADER_LEN) {
+        return STATUS_ERROR;
+    }
+
+    Aes256GcmChunked c;
+    size_t n, last_len;
+    if (aes256_gcm_chunked_reader_init(&c, ctx, container) != STATUS_OK || !container_layout(&c, container_len, &n, &last_len)) {
+        return STATUS_ERROR;
+    }
+
+    const uint8_t *records = container + AES256_GCM_CHUNKED_HEADER_LEN;
+    size_t record = (size_t)c.chunk_size + CHUNKED_TAG_LEN;
+    size_t len = (n - 1) * c.chunk_size + (last_len - CHUNKED_TAG_LEN);
+
+    int failed = 0;
+    bool parallel = n > 1 && len >= CHUNKED_PARALLEL_MIN && omp_get_max_threads() > 1;
+    #pragma omp parallel for schedule(static) reduction(|:failed) if(parallel)
+    for (size_t i = 0; i < n; i++) {
+        size_t rec_len = (i == n - 1) ? last_len : record;
+        if (aes256_gcm_chunked_read(&c, i, i == n - 1, records + i * record, rec_len, plaintext + i * c.chunk_size) != STATUS_OK) {
+            failed = 1;
+        }
+    }
+
+    // Ни одного байта из контейнера с подменённым чанком
+    if (failed) {
+        memset(plaintext, 0, len);
+        return STATUS_ERROR;
+    }
+
+    *plaintext_len = len;
+    return STATUS_OK;
+}
+
+Status aes256_gcm_chunked_read_at(const Aes256GcmChunked* c, const uint8_t* container, size_t container_len,
+                                  uint64_t index, uint8_t* out, size_t* out_len) {
+    if (!c || !container || !out || !out_len) {
+        return STATUS_ERROR;
+    }
+
+    size_t n, last_len;
+    if (!container_layout(c, container_len, &n, &last_len) || index >= n) {
+        return STATUS_ERROR;
+    }
+
+    size_t record = (size_t)c->chunk_size + CHUNKED_TAG_LEN;
+    bool last = index == n - 1;
+    size_t rec_len = last ? last_len : record;
+    Status status = aes256_gcm_chunked_read(c, index, last, container + AES256_GCM_CHUNKED_HEADER_LEN + index * record,
+                                            rec_len, out);
+    if (status == STATUS_OK) {
+        *out_len = rec_len - CHUNKED_TAG_LEN;
+    }
+    return status;
+}
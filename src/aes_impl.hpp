@@ -0,0 +1,97 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "solution.hpp"
+
+// Внутренний интерфейс между src/aes.cpp и аппаратными/программными ядрами AES и GHASH.
+// Контекст хранит выбранные реализации как AesBackend и GhashBackend (не AUTO).
+// Все ядра работают с раундовыми ключами в стандартной байтовой раскладке (240 байт)
+// и с 32-битным big-endian счётчиком CTR, как в GCM (inc32).
+
+#if defined(__x86_64__) || defined(__i386__)
+#define AES_HAVE_X86 1
+#else
+#define AES_HAVE_X86 0
+#endif
+
+// Обнуление ключей и промежуточных секретов, которое компилятор не удаляет (src/aes.cpp)
+void secure_wipe(void* buf, size_t len);
+
+// Выход шифра либо совпадает со входом, либо не пересекается с ним. При частичном
+// перекрытии блок затирается раньше, чем прочитан (в том числе другим потоком)
+inline bool buffers_alias_ok(const uint8_t* in, const uint8_t* out, size_t len) {
+    uintptr_t a = (uintptr_t)in;
+    uintptr_t b = (uintptr_t)out;
+    return a == b || len == 0 || a + len <= b || b + len <= a;
+}
+
+
+// Табличный GHASH (src/ghash_shoup.cpp). Таблица: 16 (4 бита) или 256 (8 бит)
+// кратных H парами 64-битных слов
+void shoup4_init(const uint8_t* h, uint64_t* table);
+void shoup8_init(const uint8_t* h, uint64_t* table);
+void shoup4_ghash(const uint64_t* table, uint8_t* x, const uint8_t* data, size_t nblocks);
+void shoup8_ghash(const uint64_t* table, uint8_t* x, const uint8_t* data, size_t nblocks);
+
+// out = a * b в GF(2^128) без таблиц и ветвлений по данным
+void gf128_mul(const uint8_t* a, const uint8_t* b, uint8_t* out);
+
+// Обратный S-box (src/aes.cpp): прямой обратный шифр и последний раунд T-табличного ECB
+extern const uint8_t INV_SBOX[256];
+
+// T-табличное ядро (src/aes_ttable.cpp)
+void ttable_encrypt_block(const uint8_t* w, const uint8_t* in, uint8_t* out);
+void ttable_ctr32(const uint8_t* w, const uint8_t* counter, const uint8_t* in, uint8_t* out, size_t len);
+
+// ECB по nblocks полным блокам. dw - ключи эквивалентного обратного шифра
+// (w в обратном порядке, InvMixColumns на раундах 1..13), как для AESDEC
+void ttable_ecb_encrypt(const uint8_t* w, const uint8_t* in, uint8_t* out, size_t nblocks);
+void ttable_ecb_decrypt(const uint8_t* dw, const uint8_t* in, uint8_t* out, size_t nblocks);
+
+// Битслайсинговое ядро (src/aes_bitsliced.cpp): константное время, 8 блоков за проход.
+// Расписание ключа тоже без таблиц; sk - 15 раундовых ключей по 8 битовых плоскостей
+void bitsliced_key_expansion(const uint8_t* key, uint8_t* w, uint64_t* sk);
+void bitsliced_encrypt_block(const uint64_t* sk, const uint8_t* in, uint8_t* out);
+void bitsliced_ctr32(const uint64_t* sk, const uint8_t* counter, const uint8_t* in, uint8_t* out, size_t len);
+// ECB; расшифрование обратным шифром на тех же sk
+void bitsliced_ecb_encrypt(const uint64_t* sk, const uint8_t* in, uint8_t* out, size_t nblocks);
+void bitsliced_ecb_decrypt(const uint64_t* sk, const uint8_t* in, uint8_t* out, size_t nblocks);
+
+#if AES_HAVE_X86
+// AES-NI + PCLMULQDQ + SSE4.1 (cpuid)
+bool cpu_has_aesni();
+// PCLMULQDQ + SSE4.1 (cpuid), достаточно для clmul_ghash
+bool cpu_has_pclmul();
+
+void aesni_key_expansion(const uint8_t* key, uint8_t* w);
+void aesni_encrypt_block(const uint8_t* w, const uint8_t* in, uint8_t* out);
+
+// out = in ^ E(K, counter + i), len байт, последний блок может быть неполным
+void aesni_ctr32(const uint8_t* w, const uint8_t* counter, const uint8_t* in, uint8_t* out, size_t len);
+
+// out[i] = E(w[i], in[i]) для nblocks блоков с независимыми ключами
+void aesni_encrypt_blocks_multi(const uint8_t* const* w, const uint8_t* in, uint8_t* out, size_t nblocks);
+
+// ECB по 8 блоков за проход; dw строится из w через AESIMC
+void aesni_decrypt_key_expansion(const uint8_t* w, uint8_t* dw);
+void aesni_ecb_encrypt(const uint8_t* w, const uint8_t* in, uint8_t* out, size_t nblocks);
+void aesni_ecb_decrypt(const uint8_t* dw, const uint8_t* in, uint8_t* out, size_t nblocks);
+
+// Степени H^1..H^8 для агрегированной редукции (128 байт)
+void clmul_ghash_init(const uint8_t* h, uint8_t* h_powers);
+
+// out = a * b в GF(2^128) (байтовое представление GCM)
+void clmul_gf128_mul(const uint8_t* a, const uint8_t* b, uint8_t* out);
+
+// x = (...((x ^ d0) * H ^ d1) * H ...) * H по nblocks полным блокам
+void clmul_ghash(const uint8_t* h_powers, uint8_t* x, const uint8_t* data, size_t nblocks);
+
+// VAES + VPCLMULQDQ + AVX-512F/BW (cpuid). Ключи те же, что у AES-NI
+bool cpu_has_vaes();
+void vaes_ctr32(const uint8_t* w, const uint8_t* counter, const uint8_t* in, uint8_t* out, size_t len);
+
+// Степени H^16..H^1 (256 байт) и GHASH по 16 блоков с одной редукцией
+void vpclmul_ghash_init(const uint8_t* h, uint8_t* h_powers);
+void vpclmul_ghash(const uint8_t* h_powers, uint8_t* x, const uint8_t* data, size_t nblocks);
+#endif
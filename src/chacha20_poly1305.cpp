@@ -0,0 +1,421 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <omp.h>
+
+#include "solution.hpp"
+#include "chacha_impl.hpp"
+
+static inline uint32_t load32_le(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void store32_le(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline uint32_t rotl32(uint32_t x, int n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+// ---------------------------------------------------------------------------
+// ChaCha20 (RFC 8439, раздел 2.3)
+// ---------------------------------------------------------------------------
+
+#define QR(a, b, c, d) \
+    a += b; d = rotl32(d ^ a, 16); \
+    c += d; b = rotl32(b ^ c, 12); \
+    a += b; d = rotl32(d ^ a, 8); \
+    c += d; b = rotl32(b ^ c, 7)
+
+static void chacha20_block(const uint32_t *state, uint32_t counter, uint8_t *out) {
+    uint32_t x[16];
+    memcpy(x, state, sizeof(x));
+    x[12] = counter;
+
+    for (int round = 0; round < 10; round++) {
+        QR(x[0], x[4], x[8], x[12]);
+        QR(x[1], x[5], x[9], x[13]);
+        QR(x[2], x[6], x[10], x[14]);
+        QR(x[3], x[7], x[11], x[15]);
+        QR(x[0], x[5], x[10], x[15]);
+        QR(x[1], x[6], x[11], x[12]);
+        QR(x[2], x[7], x[8], x[13]);
+        QR(x[3], x[4], x[9], x[14]);
+    }
+
+    for (int i = 0; i < 16; i++) {
+        store32_le(out + 4 * i, x[i] + (i == 12 ? counter : state[i]));
+    }
+}
+
+void chacha20_xor(const uint32_t* state, uint32_t counter, const uint8_t* in, uint8_t* out, size_t len) {
+    uint8_t keystream[64];
+    while (len > 0) {
+        chacha20_block(state, counter++, keystream);
+        size_t n = (len < 64) ? len : 64;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = in[i] ^ keystream[i];
+        }
+        in += n;
+        out += n;
+        len -= n;
+    }
+}
+
+// "expand 32-byte k", ключ и nonce; счётчик подставляют ядра
+static void chacha20_setup(uint32_t *state, const uint8_t *key, const uint8_t *nonce) {
+    state[0] = 0x61707865;
+    state[1] = 0x3320646e;
+    state[2] = 0x79622d32;
+    state[3] = 0x6b206574;
+    for (int i = 0; i < 8; i++) {
+        state[4 + i] = load32_le(key + 4 * i);
+    }
+    state[12] = 0;
+    for (int i = 0; i < 3; i++) {
+        state[13 + i] = load32_le(nonce + 4 * i);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Poly1305 (RFC 8439, раздел 2.5) в пяти 26-битных конечностях
+// ---------------------------------------------------------------------------
+
+void poly1305_mul(uint32_t* h, const uint32_t* r) {
+    uint32_t s1 = r[1] * 5, s2 = r[2] * 5, s3 = r[3] * 5, s4 = r[4] * 5;
+
+    uint64_t d0 = (uint64_t)h[0] * r[0] + (uint64_t)h[1] * s4 + (uint64_t)h[2] * s3 + (uint64_t)h[3] * s2 + (uint64_t)h[4] * s1;
+    uint64_t d1 = (uint64_t)h[0] * r[1] + (uint64_t)h[1] * r[0] + (uint64_t)h[2] * s4 + (uint64_t)h[3] * s3 + (uint64_t)h[4] * s2;
+    uint64_t d2 = (uint64_t)h[0] * r[2] + (uint64_t)h[1] * r[1] + (uint64_t)h[2] * r[0] + (uint64_t)h[3] * s4 + (uint64_t)h[4] * s3;
+    uint64_t d3 = (uint64_t)h[0] * r[3] + (uint64_t)h[1] * r[2] + (uint64_t)h[2] * r[1] + (uint64_t)h[3] * r[0] + (uint64_t)h[4] * s4;
+    uint64_t d4 = (uint64_t)h[0] * r[4] + (uint64_t)h[1] * r[3] + (uint64_t)h[2] * r[2] + (uint64_t)h[3] * r[1] + (uint64_t)h[4] * r[0];
+
+    // 2^130 = 5 mod p
+    d1 += d0 >> 26;
+    d2 += d1 >> 26;
+    d3 += d2 >> 26;
+    d4 += d3 >> 26;
+    uint32_t c = (uint32_t)(d4 >> 26);
+    h[0] = (uint32_t)d0 & 0x3ffffff;
+    h[1] = (uint32_t)d1 & 0x3ffffff;
+    h[2] = (uint32_t)d2 & 0x3ffffff;
+    h[3] = (uint32_t)d3 & 0x3ffffff;
+    h[4] = (uint32_t)d4 & 0x3ffffff;
+    h[0] += c * 5;
+    h[1] += h[0] >> 26;
+    h[0] &= 0x3ffffff;
+}
+
+void poly1305_blocks(const uint32_t* r, uint32_t* h, const uint8_t* data, size_t nblocks) {
+    for (size_t i = 0; i < nblocks; i++, data += 16) {
+        h[0] += load32_le(data) & 0x3ffffff;
+        h[1] += (load32_le(data + 3) >> 2) & 0x3ffffff;
+        h[2] += (load32_le(data + 6) >> 4) & 0x3ffffff;
+        h[3] += (load32_le(data + 9) >> 6) & 0x3ffffff;
+        h[4] += (load32_le(data + 12) >> 8) | (1 << 24);
+        poly1305_mul(h, r);
+    }
+}
+
+// r зажимается по RFC, степени r^2..r^4 - для векторного ядра
+static void poly1305_key_setup(Poly1305Key *key, const uint8_t *otk) {
+    uint32_t *r = key->r[0];
+    r[0] = load32_le(otk) & 0x3ffffff;
+    r[1] = (load32_le(otk + 3) >> 2) & 0x3ffff03;
+    r[2] = (load32_le(otk + 6) >> 4) & 0x3ffc0ff;
+    r[3] = (load32_le(otk + 9) >> 6) & 0x3f03fff;
+    r[4] = (load32_le(otk + 12) >> 8) & 0x00fffff;
+    for (int k = 1; k < 4; k++) {
+        memcpy(key->r[k], key->r[k - 1], sizeof(key->r[k]));
+        poly1305_mul(key->r[k], r);
+    }
+    for (int i = 0; i < 4; i++) {
+        key->s[i] = load32_le(otk + 16 + 4 * i);
+    }
+}
+
+// out = r^n (n >= 1) для склейки частичных сумм разных потоков
+static void poly1305_pow(const uint32_t *r, size_t n, uint32_t *out) {
+    uint32_t base[5];
+    memcpy(base, r, sizeof(base));
+    bool first = true;
+    while (n > 0) {
+        if (n & 1) {
+            if (first) {
+                memcpy(out, base, sizeof(base));
+                first = false;
+            } else {
+                poly1305_mul(out, base);
+            }
+        }
+        n >>= 1;
+        if (n > 0) {
+            uint32_t sq[5];
+            memcpy(sq, base, sizeof(sq));
+            poly1305_mul(sq, base);
+            memcpy(base, sq, sizeof(base));
+        }
+    }
+}
+
+// tag = (h mod p + s) mod 2^128, без ветвлений по h
+static void poly1305_finish(const Poly1305Key *key, uint32_t *h, uint8_t *tag) {
+    uint32_t h0 = h[0], h1 = h[1], h2 = h[2], h3 = h[3], h4 = h[4], c;
+    c = h1 >> 26; h1 &= 0x3ffffff; h2 += c;
+    c = h2 >> 26; h2 &= 0x3ffffff; h3 += c;
+    c = h3 >> 26; h3 &= 0x3ffffff; h4 += c;
+    c = h4 >> 26; h4 &= 0x3ffffff; h0 += c * 5;
+    c = h0 >> 26; h0 &= 0x3ffffff; h1 += c;
+
+    // g = h + 5 - 2^130; если g >= 0, то h >= p и берём g
+    uint32_t g0 = h0 + 5; c = g0 >> 26; g0 &= 0x3ffffff;
+    uint32_t g1 = h1 + c; c = g1 >> 26; g1 &= 0x3ffffff;
+    uint32_t g2 = h2 + c; c = g2 >> 26; g2 &= 0x3ffffff;
+    uint32_t g3 = h3 + c; c = g3 >> 26; g3 &= 0x3ffffff;
+    uint32_t g4 = h4 + c - (1 << 26);
+
+    uint32_t mask = (g4 >> 31) - 1; // все единицы, если g >= 0
+    h0 = (h0 & ~mask) | (g0 & mask);
+    h1 = (h1 & ~mask) | (g1 & mask);
+    h2 = (h2 & ~mask) | (g2 & mask);
+    h3 = (h3 & ~mask) | (g3 & mask);
+    h4 = (h4 & ~mask) | (g4 & mask);
+
+    // Упаковка в 4 слова и сложение с s по модулю 2^128
+    uint32_t w0 = h0 | (h1 << 26);
+    uint32_t w1 = (h1 >> 6) | (h2 << 20);
+    uint32_t w2 = (h2 >> 12) | (h3 << 14);
+    uint32_t w3 = (h3 >> 18) | (h4 << 8);
+
+    uint64_t f = (uint64_t)w0 + key->s[0];
+    store32_le(tag, (uint32_t)f);
+    f = (uint64_t)w1 + key->s[1] + (f >> 32);
+    store32_le(tag + 4, (uint32_t)f);
+    f = (uint64_t)w2 + key->s[2] + (f >> 32);
+    store32_le(tag + 8, (uint32_t)f);
+    f = (uint64_t)w3 + key->s[3] + (f >> 32);
+    store32_le(tag + 12, (uint32_t)f);
+}
+
+// ---------------------------------------------------------------------------
+// Выбор ядер
+// ---------------------------------------------------------------------------
+
+static bool chacha_backend_supported(ChachaBackend backend) {
+    switch (backend) {
+    case CHACHA_BACKEND_AUTO:
+    case CHACHA_BACKEND_PORTABLE:
+        return true;
+#if AES_HAVE_X86
+    case CHACHA_BACKEND_AVX2: {
+        static const bool has_avx2 = cpu_has_avx2();
+        return has_avx2;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+static ChachaBackend selected_chacha_backend = CHACHA_BACKEND_AUTO;
+
+Status chacha20_poly1305_set_backend(ChachaBackend backend) {
+    if (!chacha_backend_supported(backend)) {
+        return STATUS_ERROR;
+    }
+    selected_chacha_backend = backend;
+    return STATUS_OK;
+}
+
+static ChachaBackend resolve_chacha_backend() {
+    ChachaBackend backend = selected_chacha_backend;
+    if (backend == CHACHA_BACKEND_AUTO) {
+        backend = chacha_backend_supported(CHACHA_BACKEND_AVX2) ? CHACHA_BACKEND_AVX2 : CHACHA_BACKEND_PORTABLE;
+    }
+    return backend;
+}
+
+static void keystream_xor(ChachaBackend backend, const uint32_t *state, uint32_t counter,
+                          const uint8_t *in, uint8_t *out, size_t len) {
+#if AES_HAVE_X86
+    if (backend == CHACHA_BACKEND_AVX2) {
+        avx2_chacha20_xor(state, counter, in, out, len);
+        return;
+    }
+#endif
+    (void)backend;
+    chacha20_xor(state, counter, in, out, len);
+}
+
+static void mac_blocks(ChachaBackend backend, const Poly1305Key *key, uint32_t *h, const uint8_t *data, size_t nblocks) {
+#if AES_HAVE_X86
+    if (backend == CHACHA_BACKEND_AVX2) {
+        avx2_poly1305_blocks(key, h, data, nblocks);
+        return;
+    }
+#endif
+    (void)backend;
+    poly1305_blocks(key->r[0], h, data, nblocks);
+}
+
+// Полные блоки и хвост, дополненный нулями до 16 байт (pad16 из RFC 8439)
+static void mac_padded(ChachaBackend backend, const Poly1305Key *key, uint32_t *h, const uint8_t *data, size_t len) {
+    size_t full = len / 16;
+    mac_blocks(backend, key, h, data, full);
+    if (len % 16) {
+        uint8_t block[16] = {0};
+        memcpy(block, data + full * 16, len % 16);
+        poly1305_blocks(key->r[0], h, block, 1);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// AEAD (RFC 8439, раздел 2.8)
+// ---------------------------------------------------------------------------
+
+// Счётчик 32-битный и начинается с 1: не больше 2^32 - 1 блоков по 64 байта
+static const uint64_t CHACHA_MAX_LEN = ((1ULL << 32) - 1) * 64;
+// Как и в GCM, потоки запускаются только для длинных сообщений
+static const size_t CHACHA_PARALLEL_MIN = 64 * 1024;
+// Плитка, на которой шифрование и Poly1305 идут подряд, пока данные в L1
+static const size_t CHACHA_TILE = 4096;
+
+// Байты [start, end) сообщения: гамма и Poly1305 шифртекста плитками.
+// start кратен 64; h - частичная сумма только этого диапазона
+static void crypt_range(ChachaBackend backend, const uint32_t *state, const Poly1305Key *key,
+                        const uint8_t *in, uint8_t *out, size_t start, size_t end, uint32_t *h, bool decrypt) {
+    for (size_t pos = start; pos < end; pos += CHACHA_TILE) {
+        size_t n = (end - pos < CHACHA_TILE) ? end - pos : CHACHA_TILE;
+        if (decrypt) {
+            mac_padded(backend, key, h, in + pos, n);
+        }
+        keystream_xor(backend, state, (uint32_t)(1 + pos / 64), in + pos, out + pos, n);
+        if (!decrypt) {
+            mac_padded(backend, key, h, out + pos, n);
+        }
+    }
+}
+
+static void chacha_aead(const uint8_t *key, const uint8_t *nonce, const uint8_t *aad, size_t aad_len,
+                        const uint8_t *in, uint8_t *out, size_t len, uint8_t *tag, bool decrypt) {
+    ChachaBackend backend = resolve_chacha_backend();
+
+    uint32_t state[16];
+    chacha20_setup(state, key, nonce);
+
+    // Одноразовый ключ Poly1305 - первые 32 байта блока с нулевым счётчиком
+    uint8_t otk[64];
+    chacha20_block(state, 0, otk);
+    Poly1305Key mac_key;
+    poly1305_key_setup(&mac_key, otk);
+
+    uint32_t h[5] = {0, 0, 0, 0, 0};
+    mac_padded(backend, &mac_key, h, aad, aad_len);
+
+    int max_threads = omp_get_max_threads();
+    if (len < CHACHA_PARALLEL_MIN || max_threads == 1) {
+        crypt_range(backend, state, &mac_key, in, out, 0, len, h, decrypt);
+    } else {
+        // Непрерывные диапазоны по 64 байта на поток; частичные суммы склеиваются
+        // по Горнеру: h = h * r^n_t + h_t, где n_t - число блоков Poly1305 потока
+        size_t nchunks = (len + 63) / 64;
+        std::vector<uint32_t> partial(5 * max_threads, 0);
+        std::vector<size_t> range_end(max_threads + 1, 0);
+        int used_threads = 1;
+
+        #pragma omp parallel
+        {
+            int t = omp_get_thread_num();
+            int T = omp_get_num_threads();
+            size_t start = (size_t)((nchunks * t) / T) * 64;
+            size_t end = (size_t)((nchunks * (t + 1)) / T) * 64;
+            if (end > len) {
+                end = len;
+            }
+            crypt_range(backend, state, &mac_key, in, out, start, end, &partial[5 * t], decrypt);
+            range_end[t + 1] = end;
+            if (t == 0) {
+                used_threads = T;
+            }
+        }
+
+        for (int t = 0; t < used_threads; t++) {
+            size_t nblocks = (range_end[t + 1] - range_end[t] + 15) / 16;
+            if (nblocks == 0) {
+                continue;
+            }
+            uint32_t rn[5];
+            poly1305_pow(mac_key.r[0], nblocks, rn);
+            poly1305_mul(h, rn);
+            for (int k = 0; k < 5; k++) {
+                h[k] += partial[5 * t + k];
+            }
+        }
+    }
+
+    uint8_t lengths[16];
+    for (int i = 0; i < 8; i++) {
+        lengths[i] = (uint8_t)((uint64_t)aad_len >> (8 * i));
+        lengths[8 + i] = (uint8_t)((uint64_t)len >> (8 * i));
+    }
+    poly1305_blocks(mac_key.r[0], h, lengths, 1);
+    poly1305_finish(&mac_key, h, tag);
+}
+
+Status chacha20_poly1305_encrypt_aad(const uint8_t* plaintext, uint8_t* ciphertext,
+                                     const uint8_t* key, const uint8_t* nonce, size_t plaintext_len,
+                                     const uint8_t* aad, size_t aad_len, uint8_t* tag) {
+    if (!key || !nonce || !tag) {
+        return STATUS_ERROR;
+    }
+    if ((plaintext_len > 0 && (!plaintext || !ciphertext)) || (aad_len > 0 && !aad)) {
+        return STATUS_ERROR;
+    }
+    if ((uint64_t)plaintext_len > CHACHA_MAX_LEN || !buffers_alias_ok(plaintext, ciphertext, plaintext_len)) {
+        return STATUS_ERROR;
+    }
+
+    chacha_aead(key, nonce, aad, aad_len, plaintext, ciphertext, plaintext_len, tag, false);
+    return STATUS_OK;
+}
+
+Status chacha20_poly1305(const uint8_t* plaintext, uint8_t* ciphertext,
+                         const uint8_t* key, const uint8_t* nonce, size_t plaintext_len, uint8_t* tag) {
+    return chacha20_poly1305_encrypt_aad(plaintext, ciphertext, key, nonce, plaintext_len, nullptr, 0, tag);
+}
+
+Status chacha20_poly1305_decrypt(const uint8_t* ciphertext, uint8_t* plaintext,
+                                 const uint8_t* key, const uint8_t* nonce, size_t ciphertext_len,
+                                 const uint8_t* aad, size_t aad_len, const uint8_t* tag) {
+    if (!key || !nonce || !tag) {
+        return STATUS_ERROR;
+    }
+    if ((ciphertext_len > 0 && (!ciphertext || !plaintext)) || (aad_len > 0 && !aad)) {
+        return STATUS_ERROR;
+    }
+    if ((uint64_t)ciphertext_len > CHACHA_MAX_LEN || !buffers_alias_ok(ciphertext, plaintext, ciphertext_len)) {
+        return STATUS_ERROR;
+    }
+
+    uint8_t computed[16];
+    chacha_aead(key, nonce, aad, aad_len, ciphertext, plaintext, ciphertext_len, computed, true);
+
+    uint8_t diff = 0;
+    for (int i = 0; i < 16; i++) {
+        diff |= computed[i] ^ tag[i];
+    }
+
+    // Неаутентифицированный открытый текст не отдаём
+    if (diff != 0) {
+        if (ciphertext_len > 0) {
+            memset(plaintext, 0, ciphertext_len);
+        }
+        return STATUS_ERROR;
+    }
+    return STATUS_OK;
+}
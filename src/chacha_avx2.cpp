@@ -0,0 +1,246 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "chacha_impl.hpp"
+
+#if AES_HAVE_X86
+#include <immintrin.h>
+
+// Как и ядра AES-NI, собирается без -mavx2: расширение включается атрибутом
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+bool cpu_has_avx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+// ---------------------------------------------------------------------------
+// ChaCha20: слово i состояния восьми блоков в одном регистре, блок j - в линии j
+// ---------------------------------------------------------------------------
+
+AVX2_TARGET static inline __m256i rotl16(__m256i x) {
+    const __m256i mask = _mm256_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+                                         13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2);
+    return _mm256_shuffle_epi8(x, mask);
+}
+
+AVX2_TARGET static inline __m256i rotl8(__m256i x) {
+    const __m256i mask = _mm256_set_epi8(14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+                                         14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3);
+    return _mm256_shuffle_epi8(x, mask);
+}
+
+#define ROTL_SHIFT(x, n) _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+
+#define QUARTER_ROUND(a, b, c, d) \
+    a = _mm256_add_epi32(a, b); d = rotl16(_mm256_xor_si256(d, a)); \
+    c = _mm256_add_epi32(c, d); b = ROTL_SHIFT(_mm256_xor_si256(b, c), 12); \
+    a = _mm256_add_epi32(a, b); d = rotl8(_mm256_xor_si256(d, a)); \
+    c = _mm256_add_epi32(c, d); b = ROTL_SHIFT(_mm256_xor_si256(b, c), 7)
+
+// Транспонирование 8x8 слов: a[k] - слово k восьми блоков -> a[j] - слова 0..7 блока j
+AVX2_TARGET static inline void transpose8(__m256i *a) {
+    __m256i t0 = _mm256_unpacklo_epi32(a[0], a[1]);
+    __m256i t1 = _mm256_unpackhi_epi32(a[0], a[1]);
+    __m256i t2 = _mm256_unpacklo_epi32(a[2], a[3]);
+    __m256i t3 = _mm256_unpackhi_epi32(a[2], a[3]);
+    __m256i t4 = _mm256_unpacklo_epi32(a[4], a[5]);
+    __m256i t5 = _mm256_unpackhi_epi32(a[4], a[5]);
+    __m256i t6 = _mm256_unpacklo_epi32(a[6], a[7]);
+    __m256i t7 = _mm256_unpackhi_epi32(a[6], a[7]);
+
+    // u: слова 0..3, v: слова 4..7; в 128-битных половинах блоки j и j + 4
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    __m256i v0 = _mm256_unpacklo_epi64(t4, t6);
+    __m256i v1 = _mm256_unpackhi_epi64(t4, t6);
+    __m256i v2 = _mm256_unpacklo_epi64(t5, t7);
+    __m256i v3 = _mm256_unpackhi_epi64(t5, t7);
+
+    a[0] = _mm256_permute2x128_si256(u0, v0, 0x20);
+    a[1] = _mm256_permute2x128_si256(u1, v1, 0x20);
+    a[2] = _mm256_permute2x128_si256(u2, v2, 0x20);
+    a[3] = _mm256_permute2x128_si256(u3, v3, 0x20);
+    a[4] = _mm256_permute2x128_si256(u0, v0, 0x31);
+    a[5] = _mm256_permute2x128_si256(u1, v1, 0x31);
+    a[6] = _mm256_permute2x128_si256(u2, v2, 0x31);
+    a[7] = _mm256_permute2x128_si256(u3, v3, 0x31);
+}
+
+// 8 полных блоков (512 байт) начиная со счётчика counter
+AVX2_TARGET static void chacha8(const uint32_t *state, uint32_t counter, const uint8_t *in, uint8_t *out) {
+    // Исходное состояние не держим в регистрах: их и так не хватает на 16 слов
+    __m256i x[16];
+    for (int i = 0; i < 16; i++) {
+        x[i] = _mm256_set1_epi32((int)state[i]);
+    }
+    const __m256i ctr = _mm256_add_epi32(_mm256_set1_epi32((int)counter), _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    x[12] = ctr;
+
+    for (int round = 0; round < 10; round++) {
+        QUARTER_ROUND(x[0], x[4], x[8], x[12]);
+        QUARTER_ROUND(x[1], x[5], x[9], x[13]);
+        QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+        QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+        QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+        QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+        QUARTER_ROUND(x[2], x[7], x[8], x[13]);
+        QUARTER_ROUND(x[3], x[4], x[9], x[14]);
+    }
+
+    for (int i = 0; i < 16; i++) {
+        x[i] = _mm256_add_epi32(x[i], (i == 12) ? ctr : _mm256_set1_epi32((int)state[i]));
+    }
+    transpose8(x);
+    transpose8(x + 8);
+
+    for (int j = 0; j < 8; j++) {
+        const __m256i *src = (const __m256i *)(in + 64 * j);
+        __m256i *dst = (__m256i *)(out + 64 * j);
+        _mm256_storeu_si256(dst, _mm256_xor_si256(_mm256_loadu_si256(src), x[j]));
+        _mm256_storeu_si256(dst + 1, _mm256_xor_si256(_mm256_loadu_si256(src + 1), x[8 + j]));
+    }
+}
+
+AVX2_TARGET void avx2_chacha20_xor(const uint32_t* state, uint32_t counter, const uint8_t* in, uint8_t* out, size_t len) {
+    while (len >= 512) {
+        chacha8(state, counter, in, out);
+        counter += 8;
+        in += 512;
+        out += 512;
+        len -= 512;
+    }
+
+    // Хвост - через буфер; лишние блоки гаммы просто отбрасываются
+    if (len > 0) {
+        uint8_t buf[512];
+        memcpy(buf, in, len);
+        chacha8(state, counter, buf, buf);
+        memcpy(out, buf, len);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Poly1305: 4 линии по 64 бита, в каждой 26-битная конечность своего блока.
+// Линия j накапливает блоки 4k + j с множителем r^4, в конце домножается на r^(4-j)
+// ---------------------------------------------------------------------------
+
+AVX2_TARGET static inline void poly_mul4(__m256i *h, const __m256i *r, const __m256i *s) {
+    __m256i d0 = _mm256_mul_epu32(h[0], r[0]);
+    __m256i d1 = _mm256_mul_epu32(h[0], r[1]);
+    __m256i d2 = _mm256_mul_epu32(h[0], r[2]);
+    __m256i d3 = _mm256_mul_epu32(h[0], r[3]);
+    __m256i d4 = _mm256_mul_epu32(h[0], r[4]);
+
+    d0 = _mm256_add_epi64(d0, _mm256_mul_epu32(h[1], s[4]));
+    d1 = _mm256_add_epi64(d1, _mm256_mul_epu32(h[1], r[0]));
+    d2 = _mm256_add_epi64(d2, _mm256_mul_epu32(h[1], r[1]));
+    d3 = _mm256_add_epi64(d3, _mm256_mul_epu32(h[1], r[2]));
+    d4 = _mm256_add_epi64(d4, _mm256_mul_epu32(h[1], r[3]));
+
+    d0 = _mm256_add_epi64(d0, _mm256_mul_epu32(h[2], s[3]));
+    d1 = _mm256_add_epi64(d1, _mm256_mul_epu32(h[2], s[4]));
+    d2 = _mm256_add_epi64(d2, _mm256_mul_epu32(h[2], r[0]));
+    d3 = _mm256_add_epi64(d3, _mm256_mul_epu32(h[2], r[1]));
+    d4 = _mm256_add_epi64(d4, _mm256_mul_epu32(h[2], r[2]));
+
+    d0 = _mm256_add_epi64(d0, _mm256_mul_epu32(h[3], s[2]));
+    d1 = _mm256_add_epi64(d1, _mm256_mul_epu32(h[3], s[3]));
+    d2 = _mm256_add_epi64(d2, _mm256_mul_epu32(h[3], s[4]));
+    d3 = _mm256_add_epi64(d3, _mm256_mul_epu32(h[3], r[0]));
+    d4 = _mm256_add_epi64(d4, _mm256_mul_epu32(h[3], r[1]));
+
+    d0 = _mm256_add_epi64(d0, _mm256_mul_epu32(h[4], s[1]));
+    d1 = _mm256_add_epi64(d1, _mm256_mul_epu32(h[4], s[2]));
+    d2 = _mm256_add_epi64(d2, _mm256_mul_epu32(h[4], s[3]));
+    d3 = _mm256_add_epi64(d3, _mm256_mul_epu32(h[4], s[4]));
+    d4 = _mm256_add_epi64(d4, _mm256_mul_epu32(h[4], r[0]));
+
+    // Переносы как в скалярной версии: 2^130 = 5 mod p
+    const __m256i mask = _mm256_set1_epi64x(0x3ffffff);
+    d1 = _mm256_add_epi64(d1, _mm256_srli_epi64(d0, 26));
+    d0 = _mm256_and_si256(d0, mask);
+    d2 = _mm256_add_epi64(d2, _mm256_srli_epi64(d1, 26));
+    d1 = _mm256_and_si256(d1, mask);
+    d3 = _mm256_add_epi64(d3, _mm256_srli_epi64(d2, 26));
+    d2 = _mm256_and_si256(d2, mask);
+    d4 = _mm256_add_epi64(d4, _mm256_srli_epi64(d3, 26));
+    d3 = _mm256_and_si256(d3, mask);
+    __m256i c = _mm256_srli_epi64(d4, 26);
+    d4 = _mm256_and_si256(d4, mask);
+    d0 = _mm256_add_epi64(d0, _mm256_add_epi64(c, _mm256_slli_epi64(c, 2)));
+    d1 = _mm256_add_epi64(d1, _mm256_srli_epi64(d0, 26));
+    d0 = _mm256_and_si256(d0, mask);
+
+    h[0] = d0;
+    h[1] = d1;
+    h[2] = d2;
+    h[3] = d3;
+    h[4] = d4;
+}
+
+// m[k] += конечность k блоков data[0..3] со старшим битом 2^128
+AVX2_TARGET static inline void poly_load4(__m256i *m, const uint8_t *data) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)data);
+    __m256i b = _mm256_loadu_si256((const __m256i *)(data + 32));
+    // unpack даёт порядок блоков 0, 2, 1, 3; permute возвращает 0, 1, 2, 3
+    __m256i lo = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), 0xd8);
+    __m256i hi = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), 0xd8);
+
+    const __m256i mask = _mm256_set1_epi64x(0x3ffffff);
+    m[0] = _mm256_add_epi64(m[0], _mm256_and_si256(lo, mask));
+    m[1] = _mm256_add_epi64(m[1], _mm256_and_si256(_mm256_srli_epi64(lo, 26), mask));
+    m[2] = _mm256_add_epi64(m[2], _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(lo, 52),
+                                                                   _mm256_slli_epi64(hi, 12)), mask));
+    m[3] = _mm256_add_epi64(m[3], _mm256_and_si256(_mm256_srli_epi64(hi, 14), mask));
+    m[4] = _mm256_add_epi64(m[4], _mm256_or_si256(_mm256_srli_epi64(hi, 40), _mm256_set1_epi64x(1 << 24)));
+}
+
+AVX2_TARGET void avx2_poly1305_blocks(const Poly1305Key* key, uint32_t* h, const uint8_t* data, size_t nblocks) {
+    size_t nvec = nblocks & ~(size_t)3;
+    if (nvec < 8) {
+        poly1305_blocks(key->r[0], h, data, nblocks);
+        return;
+    }
+
+    __m256i r4[5], s4[5], rl[5], sl[5], acc[5];
+    for (int k = 0; k < 5; k++) {
+        r4[k] = _mm256_set1_epi64x(key->r[3][k]);
+        s4[k] = _mm256_set1_epi64x(key->r[3][k] * 5);
+        // Линия 0 - r^4, линия 3 - r^1
+        rl[k] = _mm256_set_epi64x(key->r[0][k], key->r[1][k], key->r[2][k], key->r[3][k]);
+        sl[k] = _mm256_set_epi64x(key->r[0][k] * 5, key->r[1][k] * 5, key->r[2][k] * 5, key->r[3][k] * 5);
+        // Накопленное h входит в первый блок линии 0 и получает множитель r^nvec
+        acc[k] = _mm256_set_epi64x(0, 0, 0, h[k]);
+    }
+
+    poly_load4(acc, data);
+    for (size_t i = 4; i < nvec; i += 4) {
+        poly_mul4(acc, r4, s4);
+        poly_load4(acc, data + 16 * i);
+    }
+    poly_mul4(acc, rl, sl);
+
+    // Сумма линий (конечности < 2^28) и перенос обратно к 26 битам
+    uint64_t lanes[4], d[5];
+    for (int k = 0; k < 5; k++) {
+        _mm256_storeu_si256((__m256i *)lanes, acc[k]);
+        d[k] = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    uint64_t c = 0;
+    for (int k = 0; k < 5; k++) {
+        d[k] += c;
+        c = d[k] >> 26;
+        h[k] = (uint32_t)(d[k] & 0x3ffffff);
+    }
+    h[0] += (uint32_t)(c * 5);
+    h[1] += h[0] >> 26;
+    h[0] &= 0x3ffffff;
+
+    poly1305_blocks(key->r[0], h, data + 16 * nvec, nblocks - nvec);
+}
+
+#endif
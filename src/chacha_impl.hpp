@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "aes_impl.hpp"
+
+// Внутренний интерфейс между src/chacha20_poly1305.cpp и ядрами ChaCha20/Poly1305.
+// Состояние ChaCha20 - 16 слов по RFC 8439 (константы, ключ, счётчик, nonce),
+// счётчик 32-битный. Poly1305 считается в пяти 26-битных конечностях.
+
+// Ключ Poly1305: степени r^1..r^4 (r^2..r^4 нужны только векторному ядру) и s
+struct Poly1305Key {
+    uint32_t r[4][5];
+    uint32_t s[4];
+};
+
+// Переносимые ядра (src/chacha20_poly1305.cpp)
+// out = in ^ ChaCha20(state, counter + i), len байт, последний блок может быть неполным
+void chacha20_xor(const uint32_t* state, uint32_t counter, const uint8_t* in, uint8_t* out, size_t len);
+
+// h = h * r mod p (неполная редукция, конечности h могут чуть превышать 2^26)
+void poly1305_mul(uint32_t* h, const uint32_t* r);
+
+// h = (...((h + m0) * r + m1) * r ...) * r по nblocks полным блокам
+void poly1305_blocks(const uint32_t* r, uint32_t* h, const uint8_t* data, size_t nblocks);
+
+#if AES_HAVE_X86
+// AVX2 (cpuid)
+bool cpu_has_avx2();
+
+// 8 блоков ChaCha20 за проход, результат совпадает с chacha20_xor
+void avx2_chacha20_xor(const uint32_t* state, uint32_t counter, const uint8_t* in, uint8_t* out, size_t len);
+
+// Poly1305 по 4 блока на 4 линиях с умножением на r^4, результат совпадает с poly1305_blocks
+void avx2_poly1305_blocks(const Poly1305Key* key, uint32_t* h, const uint8_t* data, size_t nblocks);
+#endif
@@ -6,6 +6,7 @@
 #include <omp.h>
 
 #include "solution.hpp"
+#include "crc_impl.hpp"
 
 constexpr uint32_t POLY = 0xEDB88320;
 
@@ -529,8 +530,81 @@ static constexpr uint32_t crc_table[] = {
     0xf088c1a2, 0x5ee05033, 0x7728e4c1, 0xd9407550, 0x24b98d25, 0x8ad11cb4, 0xa319a846, 0x0d7139d7,
 };
 
-Status crc32_block(const uint8_t* data, size_t data_len, uint32_t* result) {
-    uint32_t crc = 0xFFFFFFFF;
+// Склейка по алгебре CRC (как в zlib 1.2.12+): CRC(A || B) = CRC(A) * x^(8 * len(B)) mod P ^ CRC(B).
+// P неприводим и примитивен, порядок x равен 2^32 - 1
+const CrcField CRC32_FIELD = {
+    POLY,
+    32,
+    {0x40000000, 0x20000000, 0x08000000, 0x00800000, 0x00008000, 0xedb88320, 0xb1e6b092, 0xa06a2517,
+     0xed627dae, 0x88d14467, 0xd7bbfe6a, 0xec447f11, 0x8e7ea170, 0x6427800e, 0x4d47bae0, 0x09fe548f,
+     0x83852d0f, 0x30362f1a, 0x7b5a9cc3, 0x31fec169, 0x9fec022a, 0x6c8dedc4, 0x15d6874d, 0x5fde7a4e,
+     0xbad90e37, 0x2e4e5eef, 0x4eaba214, 0xa8a472c0, 0x429a969e, 0x148d302a, 0xc40ba6d0, 0xc4e22c3c},
+    {0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+     0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c},
+};
+
+// a * b mod P: схема Горнера по 4-битным группам a от старших степеней x;
+// кратные b для всех 16 значений группы собираются из b, b*x, b*x^2, b*x^3
+uint32_t multmodp(const CrcField* f, uint32_t a, uint32_t b) {
+    uint32_t mul[16];
+    mul[0] = 0;
+    mul[8] = b;
+    for (int k = 4; k >= 1; k >>= 1) {
+        b = (b >> 1) ^ (f->poly & (0u - (b & 1)));
+        mul[k] = b;
+    }
+    for (int n = 3; n < 16; n++) {
+        int low = n & -n;
+        if (n != low) {
+            mul[n] = mul[low] ^ mul[n ^ low];
+        }
+    }
+
+    uint32_t p = 0;
+    for (int shift = 0; shift < 32; shift += 4) {
+        p = (p >> 4) ^ f->red4[p & 15] ^ mul[(a >> shift) & 15];
+    }
+    return p;
+}
+
+// x^(n * 2^k) mod P по двоичному разложению n
+uint32_t x2nmodp(const CrcField* f, size_t n, unsigned k) {
+    uint32_t p = 1u << 31;
+    while (n) {
+        if (n & 1) {
+            p = multmodp(f, f->x2n[k % f->period], p);
+        }
+        n >>= 1;
+        k++;
+    }
+    return p;
+}
+
+static uint32_t crc_combine(const CrcField* f, uint32_t crc1, uint32_t crc2, size_t len2) {
+    return multmodp(f, x2nmodp(f, len2, 3), crc1) ^ crc2;
+}
+
+CrcShiftTable::CrcShiftTable(const CrcField* f, size_t len) {
+    uint32_t xn = x2nmodp(f, len, 3);
+    for (int k = 0; k < 4; k++) {
+        for (uint32_t b = 0; b < 256; b++) {
+            t[k][b] = multmodp(f, xn, b << (8 * k));
+        }
+    }
+}
+
+// Порядок байт платформы для чтения данных словами
+static inline uint64_t load64_le(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+// Slicing-by-16 над сырым регистром CRC; table - 16 таблиц по 256 слов
+static uint32_t slicing16_update(const uint32_t* table, uint32_t crc, const uint8_t* data, size_t data_len) {
     size_t i = 0;
 
     for (; i + 15 < data_len; i += 16) {
@@ -540,72 +614,188 @@ Status crc32_block(const uint8_t* data, size_t data_len, uint32_t* result) {
         uint32_t c3 = data[i+3] ^ ((crc >> 24) & 0xFF);
                 
         crc = 
-            crc_table[0*256 + data[i+15]] ^
-            crc_table[1*256 + data[i+14]] ^
-            crc_table[2*256 + data[i+13]] ^
-            crc_table[3*256 + data[i+12]] ^
-            crc_table[4*256 + data[i+11]] ^
-            crc_table[5*256 + data[i+10]] ^
-            crc_table[6*256 + data[i+9]] ^
-            crc_table[7*256 + data[i+8]] ^
-            crc_table[8*256 + data[i+7]] ^
-            crc_table[9*256 + data[i+6]] ^
-            crc_table[10*256 + data[i+5]] ^
-            crc_table[11*256 + data[i+4]] ^
-            crc_table[12*256 + c3] ^
-            crc_table[13*256 + c2] ^
-            crc_table[14*256 + c1] ^
-            crc_table[15*256 + c0];
+            table[0*256 + data[i+15]] ^
+            table[1*256 + data[i+14]] ^
+            table[2*256 + data[i+13]] ^
+            table[3*256 + data[i+12]] ^
+            table[4*256 + data[i+11]] ^
+            table[5*256 + data[i+10]] ^
+            table[6*256 + data[i+9]] ^
+            table[7*256 + data[i+8]] ^
+            table[8*256 + data[i+7]] ^
+            table[9*256 + data[i+6]] ^
+            table[10*256 + data[i+5]] ^
+            table[11*256 + data[i+4]] ^
+            table[12*256 + c3] ^
+            table[13*256 + c2] ^
+            table[14*256 + c1] ^
+            table[15*256 + c0];
     }
 
     for (; i < data_len; ++i) {
-        crc = (crc >> 8) ^ crc_table[(crc ^ data[i]) & 0xFF];
+        crc = (crc >> 8) ^ table[(crc ^ data[i]) & 0xFF];
+    }
+
+    return crc;
+}
+
+// Тот же шаг, но данные читаются двумя словами, а байты выделяются сдвигами.
+// В одном потоке это медленнее побайтового чтения (сдвиги удлиняют цепочку
+// через crc), а при нескольких потоках 2 загрузки данных вместо 16 оставляют
+// порты загрузки табличным обращениям
+static inline uint32_t slicing16_step(const uint32_t* table, uint32_t crc, const uint8_t* p) {
+    uint64_t lo = load64_le(p) ^ crc;
+    uint64_t hi = load64_le(p + 8);
+    return table[15*256 + (lo & 0xFF)] ^
+           table[14*256 + ((lo >> 8) & 0xFF)] ^
+           table[13*256 + ((lo >> 16) & 0xFF)] ^
+           table[12*256 + ((lo >> 24) & 0xFF)] ^
+           table[11*256 + ((lo >> 32) & 0xFF)] ^
+           table[10*256 + ((lo >> 40) & 0xFF)] ^
+           table[9*256 + ((lo >> 48) & 0xFF)] ^
+           table[8*256 + (lo >> 56)] ^
+           table[7*256 + (hi & 0xFF)] ^
+           table[6*256 + ((hi >> 8) & 0xFF)] ^
+           table[5*256 + ((hi >> 16) & 0xFF)] ^
+           table[4*256 + ((hi >> 24) & 0xFF)] ^
+           table[3*256 + ((hi >> 32) & 0xFF)] ^
+           table[2*256 + ((hi >> 40) & 0xFF)] ^
+           table[1*256 + ((hi >> 48) & 0xFF)] ^
+           table[0*256 + (hi >> 56)];
+}
+
+// Шаги одного потока зависят друг от друга через crc (~десяток тактов на 16 байт),
+// поэтому данные режутся на три соседних отрезка по CRC_STREAM_SPAN байт, которые
+// считаются в одном цикле вперемешку, а их CRC склеиваются сдвигом регистра
+static const size_t CRC_STREAM_SPAN = 2048;
+
+// shift - сдвиг на CRC_STREAM_SPAN байт
+static uint32_t slicing16_streams(const uint32_t* table, const CrcShiftTable& shift,
+                                  uint32_t crc, const uint8_t* data, size_t data_len) {
+    for (; data_len >= 3 * CRC_STREAM_SPAN; data += 3 * CRC_STREAM_SPAN, data_len -= 3 * CRC_STREAM_SPAN) {
+        uint32_t c1 = 0, c2 = 0;
+        for (size_t i = 0; i < CRC_STREAM_SPAN; i += 16) {
+            crc = slicing16_step(table, crc, data + i);
+            c1 = slicing16_step(table, c1, data + CRC_STREAM_SPAN + i);
+            c2 = slicing16_step(table, c2, data + 2 * CRC_STREAM_SPAN + i);
+        }
+        crc = shift.shift(crc) ^ c1;
+        crc = shift.shift(crc) ^ c2;
     }
 
-    *result = crc ^ 0xFFFFFFFF;
+    return slicing16_update(table, crc, data, data_len);
+}
+
+static bool crc32_backend_supported(Crc32Backend backend) {
+    switch (backend) {
+    case CRC32_BACKEND_AUTO:
+    case CRC32_BACKEND_SLICING16:
+        return true;
+#if AES_HAVE_X86
+    case CRC32_BACKEND_CLMUL: {
+        static const bool has_pclmul = cpu_has_pclmul();
+        return has_pclmul;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+static Crc32Backend selected_crc32_backend = CRC32_BACKEND_AUTO;
+
+Status crc32_set_backend(Crc32Backend backend) {
+    if (!crc32_backend_supported(backend)) {
+        return STATUS_ERROR;
+    }
+    selected_crc32_backend = backend;
     return STATUS_OK;
 }
 
-uint32_t gf2_matrix_times(uint32_t* mat, uint32_t vec) {
-    uint32_t sum = 0;
-    int i = 0;
-    while (vec) {
-        if (vec & 1) sum ^= mat[i];
-        vec >>= 1;
-        i++;
+static Crc32Backend resolve_crc32_backend() {
+    Crc32Backend backend = selected_crc32_backend;
+    if (backend == CRC32_BACKEND_AUTO) {
+        backend = crc32_backend_supported(CRC32_BACKEND_CLMUL) ? CRC32_BACKEND_CLMUL : CRC32_BACKEND_SLICING16;
     }
-    return sum;
+    return backend;
 }
 
-void gf2_matrix_square(uint32_t* square, uint32_t* mat) {
-    for (int i = 0; i < 32; i++)
-        square[i] = gf2_matrix_times(mat, mat[i]);
+// zlib-семантика: crc - CRC уже обработанных данных (0 в начале), внутри ядер
+// регистр хранится инвертированным
+static uint32_t crc32_kernel_update(uint32_t crc, const uint8_t* data, size_t data_len) {
+    crc = ~crc;
+
+#if AES_HAVE_X86
+    // Свёртка берёт кратную 16 часть от 64 байт, хвост досчитывается таблицами
+    if (data_len >= 64 && resolve_crc32_backend() == CRC32_BACKEND_CLMUL) {
+        size_t bulk = data_len & ~(size_t)15;
+        crc = clmul_crc32(crc, data, bulk);
+        data += bulk;
+        data_len -= bulk;
+    }
+#endif
+    static const CrcShiftTable shift(&CRC32_FIELD, CRC_STREAM_SPAN);
+    crc = slicing16_streams(crc_table, shift, crc, data, data_len);
+
+    return ~crc;
+}
+
+Status crc32_block(const uint8_t* data, size_t data_len, uint32_t* result) {
+    *result = crc32_kernel_update(0, data, data_len);
+    return STATUS_OK;
 }
 
 uint32_t crc32_combine(uint32_t crc1, uint32_t crc2, size_t len2) {
-    uint32_t even[32], odd[32];
+    return crc_combine(&CRC32_FIELD, crc1, crc2, len2);
+}
+
+typedef uint32_t (*CrcUpdateFn)(uint32_t, const uint8_t*, size_t);
+typedef uint32_t (*CrcCombineFn)(uint32_t, uint32_t, size_t);
 
-    odd[0] = POLY;
-    for (int i = 1; i < 32; i++)
-        odd[i] = 1U << (i-1);
+// Нижняя граница куска на поток: запуск параллельной области стоит единицы
+// микросекунд, а ядра проходят 128 КБ примерно за 10-15 мкс
+static const size_t CRC_PART_MIN = 128 * 1024;
+// Границы кусков кратны странице, чтобы потоки не делили строки кэша и страницы
+static const size_t CRC_PART_ALIGN = 4096;
 
-    gf2_matrix_square(even, odd);
+// Буфер делится на равные куски по числу потоков (не мельче CRC_PART_MIN).
+// Первый кусок продолжает crc, остальные начинаются с нуля; частичные CRC
+// сливаются попарно деревом за log2(parts) шагов внутри той же области
+static uint32_t chunked_crc(uint32_t crc, const uint8_t* data, size_t data_len,
+                            CrcUpdateFn update, CrcCombineFn combine) {
+    size_t parts = std::min((size_t)omp_get_max_threads(), data_len / CRC_PART_MIN);
+    if (parts <= 1) {
+        return update(crc, data, data_len);
+    }
 
-    uint32_t crc = crc1;
-    size_t len = len2;
+    size_t part_len = (data_len / parts + CRC_PART_ALIGN - 1) & ~(CRC_PART_ALIGN - 1);
+    parts = (data_len + part_len - 1) / part_len;
+    std::vector<uint32_t> crc_parts(parts);
+    std::vector<size_t> len_parts(parts);
 
-    do {
-        gf2_matrix_square(odd, even);
-        if (len & 1) crc = gf2_matrix_times(even, crc);
-        len >>= 1;
-        if (len == 0) break;
-        gf2_matrix_square(even, odd);
-        if (len & 1) crc = gf2_matrix_times(odd, crc);
-        len >>= 1;
-    } while (len != 0);
+    #pragma omp parallel num_threads((int)parts)
+    {
+        #pragma omp for schedule(static)
+        for (size_t i = 0; i < parts; ++i) {
+            size_t start = i * part_len;
+            len_parts[i] = std::min(part_len, data_len - start);
+            crc_parts[i] = update(i == 0 ? crc : 0, data + start, len_parts[i]);
+        }
 
-    crc ^= crc2;
-    return crc;
+        // На шаге step кусок i поглощает соседа i + step; неявный барьер omp for
+        // разделяет шаги
+        for (size_t step = 1; step < parts; step *= 2) {
+            #pragma omp for schedule(static)
+            for (size_t i = 0; i < parts; i += 2 * step) {
+                if (i + step < parts) {
+                    crc_parts[i] = combine(crc_parts[i], crc_parts[i + step], len_parts[i + step]);
+                    len_parts[i] += len_parts[i + step];
+                }
+            }
+        }
+    }
+
+    return crc_parts[0];
 }
 
 Status crc32(const uint8_t* data, size_t data_len, uint32_t* result) {
@@ -615,23 +805,133 @@ Status crc32(const uint8_t* data, size_t data_len, uint32_t* result) {
         return STATUS_OK;
     }
 
-    size_t chunk_size = 8192*1024;
-    size_t num_blocks = (data_len + chunk_size - 1) / chunk_size;
-    std::vector<uint32_t> crc_blocks(num_blocks);
+    *result = chunked_crc(0, data, data_len, crc32_kernel_update, crc32_combine);
+    return STATUS_OK;
+}
+
+Status crc32_update(uint32_t crc, const uint8_t* data, size_t data_len, uint32_t* result) {
+    if (!result || (data_len > 0 && !data)) {
+        return STATUS_ERROR;
+    }
+    if (data_len == 0) {
+        *result = crc;
+        return STATUS_OK;
+    }
+
+    *result = chunked_crc(crc, data, data_len, crc32_kernel_update, crc32_combine);
+    return STATUS_OK;
+}
+
+// ---------------------------------------------------------------------------
+// CRC32C (Castagnoli, RFC 3720)
+// ---------------------------------------------------------------------------
+
+static const uint32_t CRC32C_POLY = 0x82F63B78;
+
+// P = (x + 1) * примитивный многочлен степени 31, поэтому x^(2^31) = x, и
+// степени x^(2^k) повторяются с периодом 31, а не 32, как у CRC32
+const CrcField CRC32C_FIELD = {
+    CRC32C_POLY,
+    31,
+    {0x40000000, 0x20000000, 0x08000000, 0x00800000, 0x00008000, 0x82f63b78, 0x6ea2d55c, 0x18b8ea18,
+     0x510ac59a, 0xb82be955, 0xb8fdb1e7, 0x88e56f72, 0x74c360a4, 0xe4172b16, 0x0d65762a, 0x35d73a62,
+     0x28461564, 0xbf455269, 0xe2ea32dc, 0xfe7740e6, 0xf946610b, 0x3c204f8f, 0x538586e3, 0x59726915,
+     0x734d5309, 0xbc1ac763, 0x7d0722cc, 0xd289cabe, 0xe94ca9bc, 0x05b74f3f, 0xa51e1f42, 0x40000000},
+    {0x00000000, 0x105ec76f, 0x20bd8ede, 0x30e349b1, 0x417b1dbc, 0x5125dad3, 0x61c69362, 0x7198540d,
+     0x82f63b78, 0x92a8fc17, 0xa24bb5a6, 0xb21572c9, 0xc38d26c4, 0xd3d3e1ab, 0xe330a81a, 0xf36e6f75},
+};
+
+// Таблицы slicing-by-16 строятся один раз при первом обращении
+struct Crc32cTable {
+    uint32_t t[16 * 256];
+
+    Crc32cTable() {
+        for (uint32_t b = 0; b < 256; b++) {
+            uint32_t crc = b;
+            for (int k = 0; k < 8; k++) {
+                crc = (crc >> 1) ^ (CRC32C_POLY & (0u - (crc & 1)));
+            }
+            t[b] = crc;
+        }
+        for (uint32_t b = 0; b < 256; b++) {
+            for (int j = 1; j < 16; j++) {
+                uint32_t prev = t[(j - 1) * 256 + b];
+                t[j * 256 + b] = (prev >> 8) ^ t[prev & 0xFF];
+            }
+        }
+    }
+};
+
+static const uint32_t* crc32c_table() {
+    static const Crc32cTable table;
+    return table.t;
+}
+
+static bool crc32c_backend_supported(Crc32cBackend backend) {
+    switch (backend) {
+    case CRC32C_BACKEND_AUTO:
+    case CRC32C_BACKEND_SLICING16:
+        return true;
+#if AES_HAVE_X86
+    case CRC32C_BACKEND_SSE42: {
+        static const bool has_sse42 = cpu_has_sse42();
+        return has_sse42;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+static Crc32cBackend selected_crc32c_backend = CRC32C_BACKEND_AUTO;
+
+Status crc32c_set_backend(Crc32cBackend backend) {
+    if (!crc32c_backend_supported(backend)) {
+        return STATUS_ERROR;
+    }
+    selected_crc32c_backend = backend;
+    return STATUS_OK;
+}
+
+static Crc32cBackend resolve_crc32c_backend() {
+    Crc32cBackend backend = selected_crc32c_backend;
+    if (backend == CRC32C_BACKEND_AUTO) {
+        backend = crc32c_backend_supported(CRC32C_BACKEND_SSE42) ? CRC32C_BACKEND_SSE42 : CRC32C_BACKEND_SLICING16;
+    }
+    return backend;
+}
+
+static uint32_t crc32c_kernel_update(uint32_t crc, const uint8_t* data, size_t data_len) {
+    crc = ~crc;
 
-    #pragma omp parallel for
-    for (size_t i = 0; i < num_blocks; ++i) {
-        size_t start = i * chunk_size;
-        size_t len = std::min(chunk_size, data_len - start);
-        crc32_block(data + start, len, &crc_blocks[i]);
+#if AES_HAVE_X86
+    if (resolve_crc32c_backend() == CRC32C_BACKEND_SSE42) {
+        return ~sse42_crc32c(crc, data, data_len);
     }
+#endif
+    static const CrcShiftTable shift(&CRC32C_FIELD, CRC_STREAM_SPAN);
+    crc = slicing16_streams(crc32c_table(), shift, crc, data, data_len);
 
-    uint32_t crc_total = crc_blocks[0];
-    for (size_t i = 1; i < num_blocks; ++i) {
-        size_t len = std::min(chunk_size, data_len - i * chunk_size);
-        crc_total = crc32_combine(crc_total, crc_blocks[i], len);
+    return ~crc;
+}
+
+uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, size_t len2) {
+    return crc_combine(&CRC32C_FIELD, crc1, crc2, len2);
+}
+
+Status crc32c(const uint8_t* data, size_t data_len, uint32_t* result) {
+    return crc32c_update(0, data, data_len, result);
+}
+
+Status crc32c_update(uint32_t crc, const uint8_t* data, size_t data_len, uint32_t* result) {
+    if (!result || (data_len > 0 && !data)) {
+        return STATUS_ERROR;
+    }
+    if (data_len == 0) {
+        *result = crc;
+        return STATUS_OK;
     }
 
-    *result = crc_total;
+    *result = chunked_crc(crc, data, data_len, crc32c_kernel_update, crc32c_combine);
     return STATUS_OK;
 }
@@ -0,0 +1,75 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "crc_impl.hpp"
+
+#if AES_HAVE_X86
+#include <immintrin.h>
+
+// Как и ядра AES-NI, собирается без -msse4.2: расширение включается атрибутом
+#define SSE42_TARGET __attribute__((target("sse4.2")))
+
+// crc32q имеет задержку 3 такта при пропускной способности 1 за такт, поэтому
+// буфер режется на три соседних отрезка, которые считаются одновременно, а их
+// CRC склеиваются сдвигом на длину отрезка (схема Марка Адлера из crc32c.c)
+static const size_t CRC32C_LONG = 8192;
+static const size_t CRC32C_SHORT = 256;
+
+bool cpu_has_sse42() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+}
+
+static inline uint64_t load64(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+// Три потока по block байт за проход, пока хватает данных
+SSE42_TARGET static inline uint64_t crc32c_3way(uint64_t crc, const uint8_t **data, size_t *len,
+                                                size_t block, const CrcShiftTable &table) {
+    const uint8_t *p = *data;
+    size_t n = *len;
+    while (n >= 3 * block) {
+        uint64_t c1 = 0, c2 = 0;
+        const uint8_t *end = p + block;
+        do {
+            crc = _mm_crc32_u64(crc, load64(p));
+            c1 = _mm_crc32_u64(c1, load64(p + block));
+            c2 = _mm_crc32_u64(c2, load64(p + 2 * block));
+            p += 8;
+        } while (p < end);
+        crc = table.shift((uint32_t)crc) ^ c1;
+        crc = table.shift((uint32_t)crc) ^ c2;
+        p += 2 * block;
+        n -= 3 * block;
+    }
+    *data = p;
+    *len = n;
+    return crc;
+}
+
+SSE42_TARGET uint32_t sse42_crc32c(uint32_t crc, const uint8_t* data, size_t len) {
+    static const CrcShiftTable long_table(&CRC32C_FIELD, CRC32C_LONG);
+    static const CrcShiftTable short_table(&CRC32C_FIELD, CRC32C_SHORT);
+
+    uint64_t c = crc;
+    while (len > 0 && ((uintptr_t)data & 7) != 0) {
+        c = _mm_crc32_u8((uint32_t)c, *data++);
+        len--;
+    }
+
+    c = crc32c_3way(c, &data, &len, CRC32C_LONG, long_table);
+    c = crc32c_3way(c, &data, &len, CRC32C_SHORT, short_table);
+
+    for (; len >= 8; data += 8, len -= 8) {
+        c = _mm_crc32_u64(c, load64(data));
+    }
+    for (; len > 0; data++, len--) {
+        c = _mm_crc32_u8((uint32_t)c, *data);
+    }
+    return (uint32_t)c;
+}
+#endif
@@ -0,0 +1,79 @@
+#include <cstddef>
+#include <cstdint>
+
+#include "crc_impl.hpp"
+
+#if AES_HAVE_X86
+#include <immintrin.h>
+
+// Как и ядра AES-NI, собирается без -mpclmul: расширение включается атрибутом
+#define CLMUL_TARGET __attribute__((target("pclmul,sse4.1")))
+
+// Константы для отражённого 0xEDB88320 (степени x по модулю P, сдвинутые на 1 бит):
+// x^(4*128+32), x^(4*128-32) - свёртка на 512 бит вперёд,
+// x^(128+32), x^(128-32) - на 128 бит, x^64 - 96 -> 64 бита,
+// P и floor(x^64 / P) - редукция Барретта
+static const uint64_t K_FOLD_512[2] = {0x0154442bd4ULL, 0x01c6e41596ULL};
+static const uint64_t K_FOLD_128[2] = {0x01751997d0ULL, 0x00ccaa009eULL};
+static const uint64_t K_FOLD_64 = 0x0163cd6124ULL;
+static const uint64_t K_BARRETT[2] = {0x01db710641ULL, 0x01f7011641ULL};
+
+static const size_t CLMUL_PREFETCH = 4096;
+
+// lo(x) * k_lo ^ hi(x) * k_hi ^ next: 128-битный остаток переносится вперёд на длину свёртки
+CLMUL_TARGET static inline __m128i fold(__m128i x, __m128i k, __m128i next) {
+    __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+    __m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(lo, hi), next);
+}
+
+CLMUL_TARGET uint32_t clmul_crc32(uint32_t crc, const uint8_t* data, size_t len) {
+    __m128i x0 = _mm_loadu_si128((const __m128i*)(data + 0));
+    __m128i x1 = _mm_loadu_si128((const __m128i*)(data + 16));
+    __m128i x2 = _mm_loadu_si128((const __m128i*)(data + 32));
+    __m128i x3 = _mm_loadu_si128((const __m128i*)(data + 48));
+    x0 = _mm_xor_si128(x0, _mm_cvtsi32_si128((int)crc));
+    data += 64;
+    len -= 64;
+
+    // Четыре независимые линии прячут задержку PCLMULQDQ. Цепочка свёрток
+    // последовательна, поэтому на больших буферах ядро упирается в задержку
+    // промахов; программная предвыборка на 4 КБ вперёд держит его у пропускной
+    // способности памяти (выход за конец буфера для prefetch безопасен)
+    __m128i k = _mm_loadu_si128((const __m128i*)K_FOLD_512);
+    for (; len >= 64; data += 64, len -= 64) {
+        _mm_prefetch((const char*)(data + CLMUL_PREFETCH), _MM_HINT_T0);
+        x0 = fold(x0, k, _mm_loadu_si128((const __m128i*)(data + 0)));
+        x1 = fold(x1, k, _mm_loadu_si128((const __m128i*)(data + 16)));
+        x2 = fold(x2, k, _mm_loadu_si128((const __m128i*)(data + 32)));
+        x3 = fold(x3, k, _mm_loadu_si128((const __m128i*)(data + 48)));
+    }
+
+    // Линии сводятся в одну, затем добираются оставшиеся 16-байтовые блоки
+    k = _mm_loadu_si128((const __m128i*)K_FOLD_128);
+    x0 = fold(x0, k, x1);
+    x0 = fold(x0, k, x2);
+    x0 = fold(x0, k, x3);
+    for (; len >= 16; data += 16, len -= 16) {
+        x0 = fold(x0, k, _mm_loadu_si128((const __m128i*)data));
+    }
+
+    // 128 -> 96 -> 64 бита
+    const __m128i mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+    __m128i t = _mm_clmulepi64_si128(x0, k, 0x10);
+    x0 = _mm_xor_si128(_mm_srli_si128(x0, 8), t);
+    t = _mm_srli_si128(x0, 4);
+    x0 = _mm_and_si128(x0, mask32);
+    x0 = _mm_clmulepi64_si128(x0, _mm_cvtsi64_si128((long long)K_FOLD_64), 0x00);
+    x0 = _mm_xor_si128(x0, t);
+
+    // Редукция Барретта 64 -> 32 бита
+    k = _mm_loadu_si128((const __m128i*)K_BARRETT);
+    t = _mm_and_si128(x0, mask32);
+    t = _mm_clmulepi64_si128(t, k, 0x10);
+    t = _mm_and_si128(t, mask32);
+    t = _mm_clmulepi64_si128(t, k, 0x00);
+    x0 = _mm_xor_si128(x0, t);
+    return (uint32_t)_mm_extract_epi32(x0, 1);
+}
+#endif
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "aes_impl.hpp"
+
+// Внутренний интерфейс между src/crc.cpp и аппаратными ядрами CRC32 и CRC32C.
+// Ядра работают с "сырым" регистром CRC (без начальной и финальной инверсии),
+// отражённые полиномы 0xEDB88320 (CRC32) и 0x82F63B78 (CRC32C).
+
+// Арифметика по модулю P для склейки CRC и сдвига регистра (src/crc.cpp).
+// Многочлены в отражённом представлении: x^0 - старший бит слова
+struct CrcField {
+    uint32_t poly;
+    unsigned period;   // x^(2^(k + period)) = x^(2^k) mod P
+    uint32_t x2n[32];  // x^(2^k) mod P, k < period
+    uint32_t red4[16]; // p * x^4 mod P = (p >> 4) ^ red4[p & 15]
+};
+
+extern const CrcField CRC32_FIELD;
+extern const CrcField CRC32C_FIELD;
+
+// a * b mod P
+uint32_t multmodp(const CrcField* f, uint32_t a, uint32_t b);
+// x^(n * 2^k) mod P
+uint32_t x2nmodp(const CrcField* f, size_t n, unsigned k);
+
+// Оператор дописывания len нулевых байт к сырому регистру: умножение на
+// x^(8 * len) mod P, разложенное на четыре байтовые таблицы. Им склеиваются
+// CRC соседних отрезков, которые многопоточные ядра считают одновременно
+struct CrcShiftTable {
+    uint32_t t[4][256];
+
+    CrcShiftTable(const CrcField* f, size_t len);
+
+    uint32_t shift(uint32_t crc) const {
+        return t[0][crc & 0xFF] ^ t[1][(crc >> 8) & 0xFF] ^ t[2][(crc >> 16) & 0xFF] ^ t[3][crc >> 24];
+    }
+};
+
+#if AES_HAVE_X86
+// Свёртка четырёх 128-битных линий через PCLMULQDQ и редукция Барретта
+// (Gopal et al., "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ").
+// len >= 64 и кратна 16; наличие PCLMULQDQ + SSE4.1 проверяет cpu_has_pclmul()
+uint32_t clmul_crc32(uint32_t crc, const uint8_t* data, size_t len);
+
+// SSE4.2 (cpuid)
+bool cpu_has_sse42();
+
+// CRC32C инструкцией crc32q в три независимых потока, любая длина
+uint32_t sse42_crc32c(uint32_t crc, const uint8_t* data, size_t len);
+#endif
@@ -1,9 +1,16 @@
 #include <cstddef> 
 #include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
 #include <random>
 #include <omp.h>
+#ifdef __linux__
+#include <sys/random.h>
+#endif
 
 #include "solution.hpp"
+#include "aes_impl.hpp"
 #include "own_gen.cpp"
 
 uint32_t skip_ahead(uint32_t seed, uint64_t k) {
@@ -146,3 +153,54 @@ Status generate_bernoulli(size_t n, uint32_t seed, float probability, float* res
     return STATUS_OK;
 }
 
+
+// 48 байт энтропии у ОС: getrandom(), если ядро его не знает - /dev/urandom
+static bool os_entropy(uint8_t *out, size_t len) {
+#ifdef __linux__
+    size_t got = 0;
+    while (got < len) {
+        ssize_t r = getrandom(out + got, len - got, 0);
+        if (r < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        got += (size_t)r;
+    }
+    if (got == len) {
+        return true;
+    }
+#endif
+    FILE *f = fopen("/dev/urandom", "rb");
+    if (!f) {
+        return false;
+    }
+    size_t got_file = fread(out, 1, len, f);
+    fclose(f);
+    return got_file == len;
+}
+
+Status generate_bytes(size_t n, const uint8_t* seed, uint8_t* result) {
+    if (n > 0 && !result) {
+        return STATUS_ERROR;
+    }
+
+    uint8_t entropy[48];
+    if (seed) {
+        memcpy(entropy, seed, sizeof(entropy));
+    } else if (!os_entropy(entropy, sizeof(entropy))) {
+        secure_wipe(entropy, sizeof(entropy));
+        return STATUS_ERROR;
+    }
+
+    Aes256CtrDrbg drbg;
+    Status status = aes256_ctr_drbg_init(&drbg, entropy, nullptr, 0);
+    if (status == STATUS_OK) {
+        status = aes256_ctr_drbg_generate(&drbg, result, n, nullptr, 0);
+    }
+
+    secure_wipe(entropy, sizeof(entropy));
+    secure_wipe(&drbg, sizeof(drbg));
+    return status;
+}
@@ -0,0 +1,181 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "aes_impl.hpp"
+
+// Табличный GHASH по Шупу: для ключа заранее считаются кратные H
+// (16 значений для 4-битного окна, 256 - для 8-битного), а умножение идёт
+// окнами по 64-битным словам. Сдвиг на окно выводит младшие биты за x^127,
+// их вклад после редукции по x^128 + x^7 + x^2 + x + 1 берётся из LAST4/LAST8.
+// Элемент таблицы i хранится парой слов: table[2*i] - старшие 64 бита, table[2*i+1] - младшие.
+
+static const uint16_t LAST4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+static const uint16_t LAST8[256] = {
+    0x0000, 0x01c2, 0x0384, 0x0246, 0x0708, 0x06ca, 0x048c, 0x054e,
+    0x0e10, 0x0fd2, 0x0d94, 0x0c56, 0x0918, 0x08da, 0x0a9c, 0x0b5e,
+    0x1c20, 0x1de2, 0x1fa4, 0x1e66, 0x1b28, 0x1aea, 0x18ac, 0x196e,
+    0x1230, 0x13f2, 0x11b4, 0x1076, 0x1538, 0x14fa, 0x16bc, 0x177e,
+    0x3840, 0x3982, 0x3bc4, 0x3a06, 0x3f48, 0x3e8a, 0x3ccc, 0x3d0e,
+    0x3650, 0x3792, 0x35d4, 0x3416, 0x3158, 0x309a, 0x32dc, 0x331e,
+    0x2460, 0x25a2, 0x27e4, 0x2626, 0x2368, 0x22aa, 0x20ec, 0x212e,
+    0x2a70, 0x2bb2, 0x29f4, 0x2836, 0x2d78, 0x2cba, 0x2efc, 0x2f3e,
+    0x7080, 0x7142, 0x7304, 0x72c6, 0x7788, 0x764a, 0x740c, 0x75ce,
+    0x7e90, 0x7f52, 0x7d14, 0x7cd6, 0x7998, 0x785a, 0x7a1c, 0x7bde,
+    0x6ca0, 0x6d62, 0x6f24, 0x6ee6, 0x6ba8, 0x6a6a, 0x682c, 0x69ee,
+    0x62b0, 0x6372, 0x6134, 0x60f6, 0x65b8, 0x647a, 0x663c, 0x67fe,
+    0x48c0, 0x4902, 0x4b44, 0x4a86, 0x4fc8, 0x4e0a, 0x4c4c, 0x4d8e,
+    0x46d0, 0x4712, 0x4554, 0x4496, 0x41d8, 0x401a, 0x425c, 0x439e,
+    0x54e0, 0x5522, 0x5764, 0x56a6, 0x53e8, 0x522a, 0x506c, 0x51ae,
+    0x5af0, 0x5b32, 0x5974, 0x58b6, 0x5df8, 0x5c3a, 0x5e7c, 0x5fbe,
+    0xe100, 0xe0c2, 0xe284, 0xe346, 0xe608, 0xe7ca, 0xe58c, 0xe44e,
+    0xef10, 0xeed2, 0xec94, 0xed56, 0xe818, 0xe9da, 0xeb9c, 0xea5e,
+    0xfd20, 0xfce2, 0xfea4, 0xff66, 0xfa28, 0xfbea, 0xf9ac, 0xf86e,
+    0xf330, 0xf2f2, 0xf0b4, 0xf176, 0xf438, 0xf5fa, 0xf7bc, 0xf67e,
+    0xd940, 0xd882, 0xdac4, 0xdb06, 0xde48, 0xdf8a, 0xddcc, 0xdc0e,
+    0xd750, 0xd692, 0xd4d4, 0xd516, 0xd058, 0xd19a, 0xd3dc, 0xd21e,
+    0xc560, 0xc4a2, 0xc6e4, 0xc726, 0xc268, 0xc3aa, 0xc1ec, 0xc02e,
+    0xcb70, 0xcab2, 0xc8f4, 0xc936, 0xcc78, 0xcdba, 0xcffc, 0xce3e,
+    0x9180, 0x9042, 0x9204, 0x93c6, 0x9688, 0x974a, 0x950c, 0x94ce,
+    0x9f90, 0x9e52, 0x9c14, 0x9dd6, 0x9898, 0x995a, 0x9b1c, 0x9ade,
+    0x8da0, 0x8c62, 0x8e24, 0x8fe6, 0x8aa8, 0x8b6a, 0x892c, 0x88ee,
+    0x83b0, 0x8272, 0x8034, 0x81f6, 0x84b8, 0x857a, 0x873c, 0x86fe,
+    0xa9c0, 0xa802, 0xaa44, 0xab86, 0xaec8, 0xaf0a, 0xad4c, 0xac8e,
+    0xa7d0, 0xa612, 0xa454, 0xa596, 0xa0d8, 0xa11a, 0xa35c, 0xa29e,
+    0xb5e0, 0xb422, 0xb664, 0xb7a6, 0xb2e8, 0xb32a, 0xb16c, 0xb0ae,
+    0xbbf0, 0xba32, 0xb874, 0xb9b6, 0xbcf8, 0xbd3a, 0xbf7c, 0xbebe
+};
+
+static inline uint64_t load_be64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static inline void store_be64(uint8_t *p, uint64_t v) {
+    for (int i = 7; i >= 0; i--) {
+        p[i] = v & 0xff;
+        v >>= 8;
+    }
+}
+
+// Кратные H для окна из bits бит: table[1 << (bits-1)] = H, дальше умножения на x
+// (сдвиг вправо в отражённом представлении), остальные индексы - суммы
+static void shoup_init(const uint8_t *h, uint64_t *table, int bits) {
+    int size = 1 << bits;
+    uint64_t vh = load_be64(h);
+    uint64_t vl = load_be64(h + 8);
+
+    table[0] = 0;
+    table[1] = 0;
+    for (int i = size >> 1; i > 0; i >>= 1) {
+        table[2 * i] = vh;
+        table[2 * i + 1] = vl;
+        uint64_t t = (vl & 1) ? 0xE100000000000000ULL : 0;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ t;
+    }
+    for (int i = 2; i < size; i <<= 1) {
+        for (int j = 1; j < i; j++) {
+            table[2 * (i + j)] = table[2 * i] ^ table[2 * j];
+            table[2 * (i + j) + 1] = table[2 * i + 1] ^ table[2 * j + 1];
+        }
+    }
+}
+
+void shoup4_init(const uint8_t *h, uint64_t *table) {
+    shoup_init(h, table, 4);
+}
+
+void shoup8_init(const uint8_t *h, uint64_t *table) {
+    shoup_init(h, table, 8);
+}
+
+static inline void shoup4_mul(const uint64_t *table, uint8_t *x) {
+    uint8_t lo = x[15] & 0x0f;
+    uint64_t zh = table[2 * lo];
+    uint64_t zl = table[2 * lo + 1];
+
+    for (int i = 15; i >= 0; i--) {
+        lo = x[i] & 0x0f;
+        uint8_t hi = (x[i] >> 4) & 0x0f;
+        uint8_t rem;
+
+        if (i != 15) {
+            rem = zl & 0x0f;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ ((uint64_t)LAST4[rem] << 48);
+            zh ^= table[2 * lo];
+            zl ^= table[2 * lo + 1];
+        }
+
+        rem = zl & 0x0f;
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ ((uint64_t)LAST4[rem] << 48);
+        zh ^= table[2 * hi];
+        zl ^= table[2 * hi + 1];
+    }
+
+    store_be64(x, zh);
+    store_be64(x + 8, zl);
+}
+
+static inline void shoup8_mul(const uint64_t *table, uint8_t *x) {
+    uint64_t zh = table[2 * x[15]];
+    uint64_t zl = table[2 * x[15] + 1];
+
+    for (int i = 14; i >= 0; i--) {
+        uint8_t rem = zl & 0xff;
+        zl = (zh << 56) | (zl >> 8);
+        zh = (zh >> 8) ^ ((uint64_t)LAST8[rem] << 48);
+        zh ^= table[2 * x[i]];
+        zl ^= table[2 * x[i] + 1];
+    }
+
+    store_be64(x, zh);
+    store_be64(x + 8, zl);
+}
+
+void shoup4_ghash(const uint64_t *table, uint8_t *x, const uint8_t *data, size_t nblocks) {
+    for (size_t i = 0; i < nblocks; i++) {
+        for (int j = 0; j < 16; j++) {
+            x[j] ^= data[i * 16 + j];
+        }
+        shoup4_mul(table, x);
+    }
+}
+
+void shoup8_ghash(const uint64_t *table, uint8_t *x, const uint8_t *data, size_t nblocks) {
+    for (size_t i = 0; i < nblocks; i++) {
+        for (int j = 0; j < 16; j++) {
+            x[j] ^= data[i * 16 + j];
+        }
+        shoup8_mul(table, x);
+    }
+}
+
+void gf128_mul(const uint8_t *a, const uint8_t *b, uint8_t *out) {
+    uint64_t ah = load_be64(a), al = load_be64(a + 8);
+    uint64_t vh = load_be64(b), vl = load_be64(b + 8);
+    uint64_t zh = 0, zl = 0;
+
+    for (int i = 0; i < 128; i++) {
+        uint64_t bit = (i < 64) ? (ah >> (63 - i)) & 1 : (al >> (127 - i)) & 1;
+        uint64_t mask = 0 - bit;
+        zh ^= vh & mask;
+        zl ^= vl & mask;
+
+        uint64_t r = 0 - (vl & 1);
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ (r & 0xE100000000000000ULL);
+    }
+
+    store_be64(out, zh);
+    store_be64(out + 8, zl);
+}
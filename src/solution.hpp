@@ -60,9 +60,27 @@ Status generate_exponential(size_t n, uint32_t seed, float lambda, float* result
  */
 Status generate_bernoulli(size_t n, uint32_t seed, float probability, float* result);
 
+/**
+ * @brief Fills a buffer with cryptographically strong random bytes.
+ *
+ * Backed by the AES-256 CTR_DRBG (see aes256_ctr_drbg_generate()), so any length
+ * is produced in one call and large outputs are generated on all threads.
+ *
+ * @param n Number of bytes to generate
+ * @param seed 48 bytes of entropy input, or nullptr to seed from the OS
+ *             (getrandom(), falling back to /dev/urandom)
+ * @param result Output buffer (n bytes)
+ * @return Status STATUS_OK on success, STATUS_ERROR on failure, including an
+ *         unavailable OS entropy source
+ */
+Status generate_bytes(size_t n, const uint8_t* seed, uint8_t* result);
+
 /**
  * @brief Encrypts data using AES-256-GCM mode.
  * 
+ * plaintext and ciphertext may be the same buffer (in-place encryption);
+ * partially overlapping buffers are rejected with STATUS_ERROR.
+ * 
  * @param plaintext Input data to encrypt
  * @param ciphertext Output buffer for encrypted data (plaintext_len + 16 bytes for tag)
  * @param key 256-bit encryption key (32 bytes)
@@ -74,6 +92,634 @@ Status generate_bernoulli(size_t n, uint32_t seed, float probability, float* res
 Status aes256_gcm(const uint8_t* plaintext, uint8_t* ciphertext,
                   const uint8_t* key, const uint8_t* iv, size_t plaintext_len, uint8_t* tag);
 
+/**
+ * @brief AES block cipher implementations used by the AES-256 functions.
+ */
+enum AesBackend {
+    AES_BACKEND_AUTO = 0,      ///< Fastest hardware tier the CPU has (VAES, AES-NI), bitsliced otherwise
+    AES_BACKEND_BYTEWISE = 1,  ///< Byte-oriented rounds with S-box and GF(2^8) tables
+    AES_BACKEND_TTABLE = 2,    ///< 32-bit columns with four fused 1 KB T-tables
+    AES_BACKEND_BITSLICED = 3, ///< Constant-time bitsliced rounds, 8 blocks per pass
+    AES_BACKEND_AESNI = 4,     ///< AES-NI instructions, 8 blocks interleaved
+    AES_BACKEND_VAES = 5       ///< VAES on 512-bit registers, 16 blocks per pass (AVX-512)
+};
+
+/**
+ * @brief Selects the AES implementation for contexts initialized afterwards.
+ *
+ * Intended for benchmarking and testing; not thread-safe with respect to
+ * concurrent aes256_gcm_init() calls. Existing contexts keep their backend.
+ *
+ * @param backend Implementation to use, AES_BACKEND_AUTO restores the default
+ * @return Status STATUS_OK on success, STATUS_ERROR if the CPU does not support it
+ */
+Status aes256_set_backend(AesBackend backend);
+
+/**
+ * @brief GHASH multiplication implementations used by AES-256-GCM.
+ */
+enum GhashBackend {
+    GHASH_BACKEND_AUTO = 0,    ///< Widest carry-less multiply the CPU has, 4-bit Shoup tables otherwise
+    GHASH_BACKEND_BITWISE = 1, ///< Bit-by-bit multiplication, no per-key tables
+    GHASH_BACKEND_SHOUP4 = 2,  ///< 4-bit Shoup tables (256 bytes per key)
+    GHASH_BACKEND_SHOUP8 = 3,  ///< 8-bit Shoup tables (4 KB per key)
+    GHASH_BACKEND_CLMUL = 4,   ///< PCLMULQDQ carry-less multiply
+    GHASH_BACKEND_VPCLMUL = 5  ///< VPCLMULQDQ on 512-bit registers, 4 blocks per instruction
+};
+
+/**
+ * @brief Selects the GHASH implementation for contexts initialized afterwards.
+ *
+ * Same rules as aes256_set_backend(); the two choices are independent.
+ *
+ * @param backend Implementation to use, GHASH_BACKEND_AUTO restores the default
+ * @return Status STATUS_OK on success, STATUS_ERROR if the CPU does not support it
+ */
+Status aes256_gcm_set_ghash_backend(GhashBackend backend);
+
+/**
+ * @brief Per-key AES-256-GCM state: expanded key schedule, hash subkey H and
+ * its precomputed powers.
+ *
+ * Filled once by aes256_gcm_init() and then shared read-only by any number of
+ * aes256_gcm_encrypt() calls, including concurrent ones. Fields are internal.
+ */
+struct Aes256GcmContext {
+    uint8_t round_keys[240];
+    uint64_t bs_round_keys[15 * 8];
+    uint8_t h[16];
+    uint8_t h_powers[16 * 16];
+    uint64_t ghash_table[2 * 256];
+    int aes_impl;
+    int ghash_impl;
+};
+
+/**
+ * @brief Prepares a reusable AES-256-GCM context from a key.
+ *
+ * @param ctx Context to initialize
+ * @param key 256-bit encryption key (32 bytes)
+ * @return Status STATUS_OK on success, error code on failure
+ */
+Status aes256_gcm_init(Aes256GcmContext* ctx, const uint8_t* key);
+
+/**
+ * @brief Encrypts data using AES-256-GCM with a key prepared by aes256_gcm_init().
+ *
+ * @param ctx Initialized key context
+ * @param plaintext Input data to encrypt
+ * @param ciphertext Output buffer for encrypted data (plaintext_len bytes)
+ * @param iv 96-bit initialization vector (12 bytes)
+ * @param plaintext_len Length of plaintext data in bytes
+ * @param tag Output buffer for authentication tag (16 bytes)
+ * @return Status STATUS_OK on success, error code on failure
+ */
+Status aes256_gcm_encrypt(const Aes256GcmContext* ctx, const uint8_t* plaintext, uint8_t* ciphertext,
+                          const uint8_t* iv, size_t plaintext_len, uint8_t* tag);
+
+/**
+ * @brief Encrypts data with additional authenticated data (AAD).
+ *
+ * The AAD is authenticated by the tag but not encrypted. Passing aad_len = 0
+ * gives the same result as aes256_gcm_encrypt(). Aliasing rules are those of
+ * aes256_gcm(): plaintext == ciphertext is allowed, partial overlap is an error.
+ *
+ * @param ctx Initialized key context
+ * @param plaintext Input data to encrypt
+ * @param ciphertext Output buffer for encrypted data (plaintext_len bytes)
+ * @param iv 96-bit initialization vector (12 bytes)
+ * @param plaintext_len Length of plaintext data in bytes
+ * @param aad Additional authenticated data, may be nullptr if aad_len is 0
+ * @param aad_len Length of AAD in bytes
+ * @param tag Output buffer for authentication tag (16 bytes)
+ * @return Status STATUS_OK on success, error code on failure
+ */
+Status aes256_gcm_encrypt_aad(const Aes256GcmContext* ctx, const uint8_t* plaintext, uint8_t* ciphertext,
+                              const uint8_t* iv, size_t plaintext_len,
+                              const uint8_t* aad, size_t aad_len, uint8_t* tag);
+
+/**
+ * @brief Encrypts a buffer in place with AES-256-GCM.
+ *
+ * Equivalent to aes256_gcm_encrypt_aad() with plaintext == ciphertext, so the
+ * caller needs no second buffer and each byte is read and written once.
+ *
+ * @param ctx Initialized key context
+ * @param data Plaintext on input, ciphertext on output (len bytes)
+ * @param iv 96-bit initialization vector (12 bytes)
+ * @param len Length of data in bytes
+ * @param aad Additional authenticated data, may be nullptr if aad_len is 0
+ * @param aad_len Length of AAD in bytes
+ * @param tag Output buffer for authentication tag (16 bytes)
+ * @return Status STATUS_OK on success, error code on failure
+ */
+Status aes256_gcm_encrypt_inplace(const Aes256GcmContext* ctx, uint8_t* data, const uint8_t* iv, size_t len,
+                                  const uint8_t* aad, size_t aad_len, uint8_t* tag);
+
+/**
+ * @brief Decrypts AES-256-GCM data and verifies its authentication tag.
+ *
+ * The ciphertext is hashed and decrypted in the same parallel pass, and the
+ * tag is compared in constant time. If verification fails, the plaintext
+ * buffer is zeroed. ciphertext and plaintext may be the same buffer;
+ * partially overlapping buffers are rejected with STATUS_ERROR.
+ *
+ * @param ctx Initialized key context
+ * @param ciphertext Encrypted data
+ * @param plaintext Output buffer for decrypted data (ciphertext_len bytes)
+ * @param iv 96-bit initialization vector (12 bytes)
+ * @param ciphertext_len Length of ciphertext in bytes
+ * @param aad Additional authenticated data, may be nullptr if aad_len is 0
+ * @param aad_len Length of AAD in bytes
+ * @param tag Expected authentication tag (16 bytes)
+ * @return Status STATUS_OK if the tag matches, STATUS_ERROR otherwise
+ */
+Status aes256_gcm_decrypt(const Aes256GcmContext* ctx, const uint8_t* ciphertext, uint8_t* plaintext,
+                          const uint8_t* iv, size_t ciphertext_len,
+                          const uint8_t* aad, size_t aad_len, const uint8_t* tag);
+
+/**
+ * @brief One message of a batched AES-256-GCM encryption.
+ */
+struct Aes256GcmBatchEntry {
+    const uint8_t* key;       ///< 256-bit encryption key (32 bytes)
+    const uint8_t* iv;        ///< 96-bit initialization vector (12 bytes)
+    const uint8_t* plaintext; ///< Input data to encrypt
+    uint8_t* ciphertext;      ///< Output buffer for encrypted data (len bytes), may equal plaintext
+    size_t len;               ///< Length of plaintext data in bytes
+    uint8_t* tag;             ///< Output buffer for authentication tag (16 bytes)
+};
+
+/**
+ * @brief Encrypts many independent messages, each with its own key and IV.
+ *
+ * Intended for short records: messages are spread across threads in small
+ * groups, and AES blocks of different messages within a group are interleaved.
+ * Adjacent entries with the same key share one key schedule. Each result is
+ * identical to aes256_gcm() on that entry.
+ *
+ * @param entries Array of messages
+ * @param count Number of entries
+ * @return Status STATUS_OK on success, STATUS_ERROR if any entry is invalid
+ * (nothing is encrypted in that case)
+ */
+Status aes256_gcm_encrypt_batch(const Aes256GcmBatchEntry* entries, size_t count);
+
+/**
+ * @brief State of an incremental AES-256-GCM encryption or decryption.
+ *
+ * Holds the counter, the GHASH accumulator and the keystream and ciphertext
+ * of an unfinished 16-byte block between aes256_gcm_stream_update() calls.
+ * One stream belongs to one message; the key context must outlive it.
+ * After aes256_gcm_stream_final() or aes256_gcm_stream_verify() the stream is
+ * finished and every further call on it returns STATUS_ERROR.
+ * Fields are internal.
+ */
+struct Aes256GcmStream {
+    const Aes256GcmContext* ctx;
+    uint8_t j0[16];
+    uint8_t counter[16];
+    uint8_t x[16];
+    uint8_t keystream[16];
+    uint8_t partial[16];
+    size_t partial_len;
+    uint64_t aad_len;
+    uint64_t total_len;
+    int decrypt;
+    int finished;
+};
+
+/**
+ * @brief Starts encrypting a message whose data will arrive in pieces.
+ *
+ * @param stream Stream state to initialize
+ * @param ctx Initialized key context
+ * @param iv 96-bit initialization vector (12 bytes)
+ * @return Status STATUS_OK on success, error code on failure
+ */
+Status aes256_gcm_stream_init(Aes256GcmStream* stream, const Aes256GcmContext* ctx, const uint8_t* iv);
+
+/**
+ * @brief Starts decrypting a message whose data will arrive in pieces.
+ *
+ * Plaintext returned by aes256_gcm_stream_update() is not authenticated until
+ * aes256_gcm_stream_verify() succeeds; the caller must not act on it before.
+ *
+ * @param stream Stream state to initialize
+ * @param ctx Initialized key context
+ * @param iv 96-bit initialization vector (12 bytes)
+ * @return Status STATUS_OK on success, error code on failure
+ */
+Status aes256_gcm_stream_init_decrypt(Aes256GcmStream* stream, const Aes256GcmContext* ctx, const uint8_t* iv);
+
+/**
+ * @brief Supplies the additional authenticated data of the message.
+ *
+ * Must be called at most once, before the first aes256_gcm_stream_update().
+ *
+ * @param stream Stream started by aes256_gcm_stream_init() or aes256_gcm_stream_init_decrypt()
+ * @param aad Additional authenticated data
+ * @param aad_len Length of AAD in bytes
+ * @return Status STATUS_OK on success, STATUS_ERROR if data was already processed
+ * or the stream is finished
+ */
+Status aes256_gcm_stream_aad(Aes256GcmStream* stream, const uint8_t* aad, size_t aad_len);
+
+/**
+ * @brief Encrypts or decrypts the next piece of the message.
+ *
+ * Pieces may have any length; the concatenated output equals what the
+ * one-shot functions would produce for the concatenated input. in and out
+ * may be the same buffer but must not partially overlap.
+ *
+ * @param stream Started stream
+ * @param in Next piece of input data
+ * @param out Output buffer for this piece (len bytes)
+ * @param len Length of the piece in bytes
+ * @return Status STATUS_OK on success, STATUS_ERROR if the message would
+ * exceed the GCM limit of 2^36 - 32 bytes, the buffers partially overlap or
+ * the stream is finished
+ */
+Status aes256_gcm_stream_update(Aes256GcmStream* stream, const uint8_t* in, uint8_t* out, size_t len);
+
+/**
+ * @brief Finishes the message and computes its authentication tag.
+ *
+ * Only for streams started with aes256_gcm_stream_init(); a decryption stream
+ * must be finished with aes256_gcm_stream_verify(), which compares the tag in
+ * constant time.
+ *
+ * @param stream Stream started by aes256_gcm_stream_init()
+ * @param tag Output buffer for authentication tag (16 bytes)
+ * @return Status STATUS_OK on success, STATUS_ERROR for a decryption stream or
+ * a stream that is already finished
+ */
+Status aes256_gcm_stream_final(Aes256GcmStream* stream, uint8_t* tag);
+
+/**
+ * @brief Finishes the message and compares its tag with the expected one in constant time.
+ *
+ * @param stream Started stream
+ * @param tag Expected authentication tag (16 bytes)
+ * @return Status STATUS_OK if the tag matches, STATUS_ERROR if it does not or
+ * the stream is already finished
+ */
+Status aes256_gcm_stream_verify(Aes256GcmStream* stream, const uint8_t* tag);
+
+/**
+ * @brief One segment of a scatter-gather list; same layout as POSIX struct iovec.
+ */
+struct Aes256GcmIovec {
+    void* base;
+    size_t len;
+};
+
+/**
+ * @brief Encrypts a message held in several buffers with AES-256-GCM.
+ *
+ * The result equals aes256_gcm_encrypt_aad() over the concatenated segments;
+ * segments may have any lengths, and the plaintext and ciphertext lists may
+ * be split differently. Large segments keep the parallel CTR/GHASH path.
+ * An output segment may be equal to the input bytes it replaces but must not
+ * overlap other input segments.
+ *
+ * @param ctx Initialized key context
+ * @param iv 96-bit initialization vector (12 bytes)
+ * @param aad Segments of additional authenticated data, may be nullptr if aad_count is 0
+ * @param aad_count Number of AAD segments
+ * @param plaintext Segments of input data
+ * @param plaintext_count Number of plaintext segments
+ * @param ciphertext Output segments, same total length as plaintext
+ * @param ciphertext_count Number of ciphertext segments
+ * @param tag Output buffer for authentication tag (16 bytes)
+ * @return Status STATUS_OK on success, STATUS_ERROR on invalid segments or length mismatch
+ */
+Status aes256_gcm_encrypt_iov(const Aes256GcmContext* ctx, const uint8_t* iv,
+                              const Aes256GcmIovec* aad, size_t aad_count,
+                              const Aes256GcmIovec* plaintext, size_t plaintext_count,
+                              const Aes256GcmIovec* ciphertext, size_t ciphertext_count, uint8_t* tag);
+
+/**
+ * @brief Decrypts a message held in several buffers and verifies its tag.
+ *
+ * Same segment rules as aes256_gcm_encrypt_iov(). If verification fails,
+ * all plaintext segments are zeroed.
+ *
+ * @param ctx Initialized key context
+ * @param iv 96-bit initialization vector (12 bytes)
+ * @param aad Segments of additional authenticated data, may be nullptr if aad_count is 0
+ * @param aad_count Number of AAD segments
+ * @param ciphertext Segments of encrypted data
+ * @param ciphertext_count Number of ciphertext segments
+ * @param plaintext Output segments, same total length as ciphertext
+ * @param plaintext_count Number of plaintext segments
+ * @param tag Expected authentication tag (16 bytes)
+ * @return Status STATUS_OK if the tag matches, STATUS_ERROR otherwise
+ */
+Status aes256_gcm_decrypt_iov(const Aes256GcmContext* ctx, const uint8_t* iv,
+                              const Aes256GcmIovec* aad, size_t aad_count,
+                              const Aes256GcmIovec* ciphertext, size_t ciphertext_count,
+                              const Aes256GcmIovec* plaintext, size_t plaintext_count, const uint8_t* tag);
+
+/**
+ * @brief Size of the chunked AES-256-GCM container header in bytes.
+ *
+ * Layout: "GCM1", chunk size (32-bit little-endian), 7-byte nonce prefix, zero byte.
+ * The header is the AAD of every chunk. It is followed by one record per chunk,
+ * ciphertext then 16-byte tag, so record i starts at
+ * AES256_GCM_CHUNKED_HEADER_LEN + i * (chunk_size + 16).
+ */
+static const size_t AES256_GCM_CHUNKED_HEADER_LEN = 16;
+
+/**
+ * @brief Parameters of one chunked container, shared by its writer and readers.
+ *
+ * Chunk i is sealed with nonce = prefix || i (32-bit big-endian) || last-chunk flag,
+ * so chunks cannot be reordered, dropped from the end or moved between containers
+ * with different headers. Fields are internal.
+ */
+struct Aes256GcmChunked {
+    const Aes256GcmContext* ctx;
+    uint8_t header[16];
+    uint32_t chunk_size;
+};
+
+/**
+ * @brief Starts a new container and produces its header.
+ *
+ * @param c Container state to initialize
+ * @param ctx Initialized key context (must outlive c)
+ * @param nonce_prefix 7 bytes, must never repeat for the same key
+ * @param chunk_size Plaintext bytes per chunk (all chunks but the last are full)
+ * @param header Output buffer (AES256_GCM_CHUNKED_HEADER_LEN bytes)
+ * @return Status STATUS_OK on success, error code on failure
+ */
+Status aes256_gcm_chunked_writer_init(Aes256GcmChunked* c, const Aes256GcmContext* ctx,
+                                      const uint8_t* nonce_prefix, uint32_t chunk_size, uint8_t* header);
+
+/**
+ * @brief Encrypts one chunk into its record; chunks may be written in any order.
+ *
+ * @param c Container state from aes256_gcm_chunked_writer_init()
+ * @param index Chunk number, below 2^32
+ * @param last Non-zero for the final chunk
+ * @param in Plaintext, exactly chunk_size bytes unless last
+ * @param len Plaintext length, at most chunk_size
+ * @param record Output buffer (len + 16 bytes)
+ * @return Status STATUS_OK on success, error code on failure
+ */
+Status aes256_gcm_chunked_write(const Aes256GcmChunked* c, uint64_t index, int last,
+                                const uint8_t* in, size_t len, uint8_t* record);
+
+/**
+ * @brief Opens an existing container from its header.
+ *
+ * @param c Container state to initialize
+ * @param ctx Initialized key context (must outlive c)
+ * @param header Container header (AES256_GCM_CHUNKED_HEADER_LEN bytes)
+ * @return Status STATUS_OK on success, STATUS_ERROR if the header is malformed
+ */
+Status aes256_gcm_chunked_reader_init(Aes256GcmChunked* c, const Aes256GcmContext* ctx, const uint8_t* header);
+
+/**
+ * @brief Verifies and decrypts one record; records may be read in any order.
+ *
+ * If verification fails, the output is zeroed.
+ *
+ * @param c Container state from aes256_gcm_chunked_reader_init()
+ * @param index Chunk number of the record
+ * @param last Non-zero if this is the final record of the container
+ * @param record Ciphertext followed by the tag
+ * @param record_len Record length, 16..chunk_size + 16 bytes
+ * @param out Output buffer (record_len - 16 bytes)
+ * @return Status STATUS_OK if the tag matches, STATUS_ERROR otherwise
+ */
+Status aes256_gcm_chunked_read(const Aes256GcmChunked* c, uint64_t index, int last,
+                               const uint8_t* record, size_t record_len, uint8_t* out);
+
+/**
+ * @brief Returns the container size for a plaintext length, header included.
+ */
+size_t aes256_gcm_chunked_size(const Aes256GcmChunked* c, size_t plaintext_len);
+
+/**
+ * @brief Encrypts a whole buffer into a container, chunks in parallel.
+ *
+ * @param c Container state from aes256_gcm_chunked_writer_init()
+ * @param plaintext Input data
+ * @param len Length of plaintext in bytes
+ * @param container Output buffer (aes256_gcm_chunked_size() bytes)
+ * @return Status STATUS_OK on success, error code on failure
+ */
+Status aes256_gcm_chunked_encrypt(const Aes256GcmChunked* c, const uint8_t* plaintext, size_t len,
+                                  uint8_t* container);
+
+/**
+ * @brief Verifies and decrypts a whole container, chunks in parallel.
+ *
+ * If any chunk fails verification or the container is truncated, the whole
+ * plaintext is zeroed.
+ *
+ * @param ctx Initialized key context
+ * @param container Header followed by the records
+ * @param container_len Container length in bytes
+ * @param plaintext Output buffer (container_len bytes are always enough)
+ * @param plaintext_len Output parameter for the plaintext length
+ * @return Status STATUS_OK on success, STATUS_ERROR otherwise
+ */
+Status aes256_gcm_chunked_decrypt(const Aes256GcmContext* ctx, const uint8_t* container, size_t container_len,
+                                  uint8_t* plaintext, size_t* plaintext_len);
+
+/**
+ * @brief Random access: verifies and decrypts chunk index of a container in memory.
+ *
+ * @param c Container state from aes256_gcm_chunked_reader_init()
+ * @param container Whole container, header included
+ * @param container_len Container length in bytes
+ * @param index Chunk number
+ * @param out Output buffer (chunk_size bytes)
+ * @param out_len Output parameter for the chunk length
+ * @return Status STATUS_OK on success, STATUS_ERROR if index is out of range or verification fails
+ */
+Status aes256_gcm_chunked_read_at(const Aes256GcmChunked* c, const uint8_t* container, size_t container_len,
+                                  uint64_t index, uint8_t* out, size_t* out_len);
+
+/**
+ * @brief Per-key AES-256-ECB state: encryption and decryption key schedules.
+ *
+ * Filled once by aes256_ecb_init() and shared read-only by concurrent calls.
+ * Fields are internal.
+ */
+struct Aes256EcbContext {
+    uint8_t enc_keys[240];
+    uint8_t dec_keys[240];
+    uint64_t bs_round_keys[15 * 8];
+    int aes_impl;
+};
+
+/**
+ * @brief Prepares a reusable AES-256-ECB context from a key.
+ *
+ * @param ctx Context to initialize
+ * @param key 256-bit encryption key (32 bytes)
+ * @return Status STATUS_OK on success, error code on failure
+ */
+Status aes256_ecb_init(Aes256EcbContext* ctx, const uint8_t* key);
+
+/**
+ * @brief Encrypts independent 16-byte blocks with AES-256 (ECB mode).
+ *
+ * Large buffers are split across threads. ECB leaks equal plaintext blocks and
+ * is meant as a building block, not as a general-purpose cipher mode.
+ *
+ * @param ctx Initialized key context
+ * @param in Input blocks
+ * @param out Output buffer (len bytes), may be equal to in but must not partially overlap it
+ * @param len Length in bytes, must be a multiple of 16
+ * @return Status STATUS_OK on success, STATUS_ERROR if len is not a multiple of 16
+ * or the buffers partially overlap
+ */
+Status aes256_ecb_encrypt(const Aes256EcbContext* ctx, const uint8_t* in, uint8_t* out, size_t len);
+
+/**
+ * @brief Decrypts independent 16-byte blocks with AES-256 (ECB mode).
+ *
+ * @param ctx Initialized key context
+ * @param in Input blocks
+ * @param out Output buffer (len bytes), may be equal to in but must not partially overlap it
+ * @param len Length in bytes, must be a multiple of 16
+ * @return Status STATUS_OK on success, STATUS_ERROR if len is not a multiple of 16
+ * or the buffers partially overlap
+ */
+Status aes256_ecb_decrypt(const Aes256EcbContext* ctx, const uint8_t* in, uint8_t* out, size_t len);
+
+/**
+ * @brief AES-256 CTR_DRBG state (NIST SP 800-90A, no derivation function).
+ *
+ * Fields are internal. The state must not be used by several threads at once.
+ */
+struct Aes256CtrDrbg {
+    uint8_t key[32];
+    uint8_t v[16];
+    uint64_t reseed_counter;
+};
+
+/**
+ * @brief Instantiates the DRBG from full-entropy input.
+ *
+ * @param drbg State to initialize
+ * @param entropy Entropy input (48 bytes, seedlen)
+ * @param personalization Optional personalization string, may be nullptr if personalization_len is 0
+ * @param personalization_len Length of the personalization string, at most 48 bytes
+ * @return Status STATUS_OK on success, error code on failure
+ */
+Status aes256_ctr_drbg_init(Aes256CtrDrbg* drbg, const uint8_t* entropy,
+                            const uint8_t* personalization, size_t personalization_len);
+
+/**
+ * @brief Mixes fresh entropy into the DRBG state and resets the reseed counter.
+ *
+ * @param drbg Instantiated state
+ * @param entropy Entropy input (48 bytes)
+ * @param additional Optional additional input, may be nullptr if additional_len is 0
+ * @param additional_len Length of the additional input, at most 48 bytes
+ * @return Status STATUS_OK on success, error code on failure
+ */
+Status aes256_ctr_drbg_reseed(Aes256CtrDrbg* drbg, const uint8_t* entropy,
+                              const uint8_t* additional, size_t additional_len);
+
+/**
+ * @brief Generates pseudo-random bytes.
+ *
+ * Requests longer than 2^19 bits are served as consecutive 64 KB Generate calls
+ * (additional input applies to the first one). Their keystreams use disjoint
+ * counter ranges and are computed in parallel for large len.
+ *
+ * @param drbg Instantiated state
+ * @param out Output buffer (len bytes)
+ * @param len Number of bytes to generate
+ * @param additional Optional additional input, may be nullptr if additional_len is 0
+ * @param additional_len Length of the additional input, at most 48 bytes
+ * @return Status STATUS_OK on success, STATUS_ERROR on invalid arguments or when
+ * a reseed is required (after 2^48 Generate calls)
+ */
+Status aes256_ctr_drbg_generate(Aes256CtrDrbg* drbg, uint8_t* out, size_t len,
+                                const uint8_t* additional, size_t additional_len);
+
+/**
+ * @brief Encrypts data using ChaCha20-Poly1305 (RFC 8439).
+ *
+ * Same calling conventions as aes256_gcm(); the fast choice on CPUs without
+ * AES-NI. plaintext and ciphertext may be the same buffer; partially
+ * overlapping buffers are rejected with STATUS_ERROR.
+ *
+ * @param plaintext Input data to encrypt
+ * @param ciphertext Output buffer for encrypted data (plaintext_len bytes)
+ * @param key 256-bit key (32 bytes)
+ * @param nonce 96-bit nonce (12 bytes)
+ * @param plaintext_len Length of plaintext data in bytes
+ * @param tag Output buffer for authentication tag (16 bytes)
+ * @return Status STATUS_OK on success, error code on failure
+ */
+Status chacha20_poly1305(const uint8_t* plaintext, uint8_t* ciphertext,
+                         const uint8_t* key, const uint8_t* nonce, size_t plaintext_len, uint8_t* tag);
+
+/**
+ * @brief Encrypts data with ChaCha20-Poly1305 and authenticates additional data.
+ *
+ * @param plaintext Input data to encrypt
+ * @param ciphertext Output buffer (plaintext_len bytes), may be equal to plaintext
+ * @param key 256-bit key (32 bytes)
+ * @param nonce 96-bit nonce (12 bytes)
+ * @param plaintext_len Length of plaintext data in bytes
+ * @param aad Additional authenticated data, may be nullptr if aad_len is 0
+ * @param aad_len Length of AAD in bytes
+ * @param tag Output buffer for authentication tag (16 bytes)
+ * @return Status STATUS_OK on success, error code on failure
+ */
+Status chacha20_poly1305_encrypt_aad(const uint8_t* plaintext, uint8_t* ciphertext,
+                                     const uint8_t* key, const uint8_t* nonce, size_t plaintext_len,
+                                     const uint8_t* aad, size_t aad_len, uint8_t* tag);
+
+/**
+ * @brief Decrypts ChaCha20-Poly1305 data and verifies its authentication tag.
+ *
+ * The tag is compared in constant time. If verification fails, the plaintext
+ * buffer is zeroed. ciphertext and plaintext may be the same buffer.
+ *
+ * @param ciphertext Encrypted data
+ * @param plaintext Output buffer (ciphertext_len bytes)
+ * @param key 256-bit key (32 bytes)
+ * @param nonce 96-bit nonce (12 bytes)
+ * @param ciphertext_len Length of ciphertext in bytes
+ * @param aad Additional authenticated data, may be nullptr if aad_len is 0
+ * @param aad_len Length of AAD in bytes
+ * @param tag Expected authentication tag (16 bytes)
+ * @return Status STATUS_OK if the tag matches, STATUS_ERROR otherwise
+ */
+Status chacha20_poly1305_decrypt(const uint8_t* ciphertext, uint8_t* plaintext,
+                                 const uint8_t* key, const uint8_t* nonce, size_t ciphertext_len,
+                                 const uint8_t* aad, size_t aad_len, const uint8_t* tag);
+
+/**
+ * @brief ChaCha20 and Poly1305 implementations used by ChaCha20-Poly1305.
+ */
+enum ChachaBackend {
+    CHACHA_BACKEND_AUTO = 0,     ///< AVX2 when the CPU has it, portable otherwise
+    CHACHA_BACKEND_PORTABLE = 1, ///< One block at a time, scalar 26-bit Poly1305
+    CHACHA_BACKEND_AVX2 = 2      ///< 8 ChaCha20 blocks per pass, 4-lane Poly1305
+};
+
+/**
+ * @brief Selects the ChaCha20-Poly1305 implementation for subsequent calls.
+ *
+ * Intended for benchmarking and testing; not thread-safe with respect to
+ * concurrent encryption calls.
+ *
+ * @param backend Implementation to use, CHACHA_BACKEND_AUTO restores the default
+ * @return Status STATUS_OK on success, STATUS_ERROR if the CPU does not support it
+ */
+Status chacha20_poly1305_set_backend(ChachaBackend backend);
 
 /**
  * @brief Calculates CRC32 checksum for the given data.
@@ -84,3 +730,114 @@ Status aes256_gcm(const uint8_t* plaintext, uint8_t* ciphertext,
  * @return Status STATUS_OK on success, error code on failure
  */
 Status crc32(const uint8_t* data, size_t data_len, uint32_t* result);
+
+/**
+ * @brief Continues a CRC32 over the next piece of a stream (zlib crc32() semantics).
+ *
+ * The running value is an ordinary finished CRC32, so it can be stored and
+ * resumed at any point: start with 0, pass each result back in, and after
+ * the last piece it equals crc32() of the concatenated data. Uses the same
+ * kernels as crc32(); large pieces are still split across threads.
+ *
+ * @param crc CRC32 of the data processed so far, 0 for the first piece
+ * @param data Next piece of data
+ * @param data_len Length of the piece in bytes, may be 0
+ * @param result Output parameter to store the CRC32 of all data so far
+ * @return Status STATUS_OK on success, STATUS_ERROR on null pointers
+ */
+Status crc32_update(uint32_t crc, const uint8_t* data, size_t data_len, uint32_t* result);
+
+/**
+ * @brief Combines the CRC32 values of two adjacent pieces of data (zlib crc32_combine()).
+ *
+ * Returns CRC32(A || B) from crc1 = CRC32(A), crc2 = CRC32(B) and the length
+ * of B, without touching the data. Costs a few GF(2)[x] multiplications by
+ * precomputed x^(2^k) mod P, independent of the data size, so pieces can be
+ * checksummed on different workers and merged afterwards.
+ *
+ * @param crc1 CRC32 of the first piece
+ * @param crc2 CRC32 of the second piece
+ * @param len2 Length of the second piece in bytes
+ * @return uint32_t CRC32 of the concatenation
+ */
+uint32_t crc32_combine(uint32_t crc1, uint32_t crc2, size_t len2);
+
+/**
+ * @brief CRC32 kernels used by crc32().
+ */
+enum Crc32Backend {
+    CRC32_BACKEND_AUTO = 0,      ///< CLMUL when the CPU has PCLMULQDQ, slicing-by-16 otherwise
+    CRC32_BACKEND_SLICING16 = 1, ///< Portable slicing-by-16 over 16 KB of tables
+    CRC32_BACKEND_CLMUL = 2      ///< PCLMULQDQ folding of 4x128-bit lanes, Barrett reduction
+};
+
+/**
+ * @brief Selects the CRC32 implementation for subsequent calls.
+ *
+ * Intended for benchmarking and testing; not thread-safe with respect to
+ * concurrent crc32() calls.
+ *
+ * @param backend Implementation to use, CRC32_BACKEND_AUTO restores the default
+ * @return Status STATUS_OK on success, STATUS_ERROR if the CPU does not support it
+ */
+Status crc32_set_backend(Crc32Backend backend);
+
+/**
+ * @brief Calculates CRC32C (Castagnoli) checksum for the given data.
+ *
+ * Uses the iSCSI/ext4 polynomial 0x1EDC6F41 (reflected 0x82F63B78) with the
+ * same initial value and final XOR as crc32(), so crc32c("123456789") is
+ * 0xE3069283. Large inputs are split into blocks that are processed in
+ * parallel and combined.
+ *
+ * @param data Input data buffer
+ * @param data_len Length of data in bytes
+ * @param result Output parameter to store the calculated CRC32C value
+ * @return Status STATUS_OK on success, STATUS_ERROR on null pointers
+ */
+Status crc32c(const uint8_t* data, size_t data_len, uint32_t* result);
+
+/**
+ * @brief Continues a CRC32C over the next piece of a stream.
+ *
+ * Same contract as crc32_update(): start with 0 and pass each result back in.
+ *
+ * @param crc CRC32C of the data processed so far, 0 for the first piece
+ * @param data Next piece of data
+ * @param data_len Length of the piece in bytes, may be 0
+ * @param result Output parameter to store the CRC32C of all data so far
+ * @return Status STATUS_OK on success, STATUS_ERROR on null pointers
+ */
+Status crc32c_update(uint32_t crc, const uint8_t* data, size_t data_len, uint32_t* result);
+
+/**
+ * @brief Combines the CRC32C values of two adjacent pieces of data.
+ *
+ * Same contract as crc32_combine().
+ *
+ * @param crc1 CRC32C of the first piece
+ * @param crc2 CRC32C of the second piece
+ * @param len2 Length of the second piece in bytes
+ * @return uint32_t CRC32C of the concatenation
+ */
+uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, size_t len2);
+
+/**
+ * @brief CRC32C kernels used by crc32c().
+ */
+enum Crc32cBackend {
+    CRC32C_BACKEND_AUTO = 0,      ///< SSE4.2 when the CPU has it, slicing-by-16 otherwise
+    CRC32C_BACKEND_SLICING16 = 1, ///< Portable slicing-by-16 over 16 KB of tables
+    CRC32C_BACKEND_SSE42 = 2      ///< Three interleaved crc32q streams merged with shift tables
+};
+
+/**
+ * @brief Selects the CRC32C implementation for subsequent calls.
+ *
+ * Intended for benchmarking and testing; not thread-safe with respect to
+ * concurrent crc32c() calls.
+ *
+ * @param backend Implementation to use, CRC32C_BACKEND_AUTO restores the default
+ * @return Status STATUS_OK on success, STATUS_ERROR if the CPU does not support it
+ */
+Status crc32c_set_backend(Crc32cBackend backend);